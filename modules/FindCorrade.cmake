@@ -38,6 +38,8 @@
 #   mode for MSVC 2015
 #  CORRADE_BUILD_DEPRECATED     - Defined if compiled with deprecated APIs
 #   included
+#  CORRADE_BUILD_INTERCONNECT_PROFILING - Defined if compiled with Interconnect
+#   signal emission profiling
 #  CORRADE_BUILD_STATIC         - Defined if compiled as static libraries
 #  CORRADE_TARGET_UNIX          - Defined if compiled for some Unix flavor
 #   (Linux, BSD, OS X)
@@ -208,6 +210,7 @@ set(_corradeFlags
     GCC47_COMPATIBILITY
     MSVC2015_COMPATIBILITY
     BUILD_DEPRECATED
+    BUILD_INTERCONNECT_PROFILING
     BUILD_STATIC
     TARGET_UNIX
     TARGET_APPLE
@@ -247,6 +250,12 @@ if(CORRADE_TARGET_UNIX OR CORRADE_TARGET_NACL_GLIBC)
     set(CORRADE_PLUGINMANAGER_LIBRARIES ${CORRADE_PLUGINMANAGER_LIBRARIES} ${CMAKE_DL_LIBS})
 endif()
 
+# Thread-safe emitters in Interconnect library need threading library
+find_package(Threads)
+if(CMAKE_THREAD_LIBS_INIT)
+    set(CORRADE_INTERCONNECT_LIBRARIES ${CORRADE_INTERCONNECT_LIBRARIES} ${CMAKE_THREAD_LIBS_INIT})
+endif()
+
 # AndroidLogStreamBuffer class needs to be linked to log library
 if(CORRADE_TARGET_ANDROID)
     set(CORRADE_UTILITY_LIBRARIES ${CORRADE_UTILITY_LIBRARIES} log)
@@ -0,0 +1,320 @@
+#ifndef Corrade_Containers_ArenaAllocator_h
+#define Corrade_Containers_ArenaAllocator_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::ArenaAllocator
+ */
+
+#include <cstdint>
+#include <new>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Utility/Assert.h"
+
+namespace Corrade { namespace Containers {
+
+namespace Implementation {
+
+/* Header of an arena memory block, followed by the memory itself. Every
+   array allocated from the block holds a reference to it and stores a
+   pointer to the block right in front of its data, so the (stateless)
+   deleter can find it. */
+struct ArenaBlock {
+    explicit ArenaBlock(std::size_t capacity): next{nullptr}, capacity{capacity}, used{0}, references{0}, orphaned{false} {}
+
+    char* data() { return reinterpret_cast<char*>(this + 1); }
+
+    ArenaBlock* next;
+    std::size_t capacity;
+    std::size_t used;
+    std::size_t references;
+    /* Set when the block was detached from its arena while there were
+       still live arrays, the last one deletes it */
+    bool orphaned;
+};
+
+inline ArenaBlock* arenaAllocateBlock(const std::size_t capacity) {
+    return new(new char[sizeof(ArenaBlock) + capacity]) ArenaBlock{capacity};
+}
+
+inline void arenaDeleteBlock(ArenaBlock* block) {
+    block->~ArenaBlock();
+    delete[] reinterpret_cast<char*>(block);
+}
+
+template<class T> void arenaDeleter(T* data, std::size_t size) {
+    if(!data) return;
+
+    for(T *it = data, *end = data + size; it != end; ++it) it->~T();
+
+    ArenaBlock* const block = reinterpret_cast<ArenaBlock**>(data)[-1];
+    CORRADE_INTERNAL_ASSERT(block->references);
+    if(!--block->references && block->orphaned) arenaDeleteBlock(block);
+}
+
+}
+
+/**
+@brief Arena allocator for arrays
+
+Hands out @ref Array instances from large memory blocks by just bumping a
+pointer, with no per-array call to `operator new[]` and `operator delete[]`.
+All memory is then reclaimed at once using @ref reset(), which makes the
+allocator suitable for per-frame scratch memory or for data that live as long
+as a single request:
+@code
+Containers::ArenaAllocator arena;
+
+for(;;) {
+    Containers::Array<Vertex> vertices = arena.allocate<Vertex>(vertexCount);
+    Containers::Array<char> text = arena.allocate<char>(Containers::ValueInit, textSize);
+    // ...
+
+    arena.reset();
+}
+@endcode
+
+The returned arrays have the default deleter type, so they can be passed to
+any code that works with @ref Array. The deleter calls destructors of the
+elements and drops a reference to the memory block, but doesn't free any
+memory. Blocks that still have live arrays on @ref reset() or on arena
+destruction are detached from the arena and deleted together with the last
+array, so arrays outliving the reset stay valid, they just prevent the block
+memory from being reused. Zero-sized arrays don't allocate anything.
+
+Allocations larger than the block size get a block of their own. Alignment of
+@p T is respected, including over-aligned types.
+
+@attention The allocator and arrays allocated from it are not thread-safe ---
+    all arrays from one arena have to be destroyed on the same thread as the
+    arena is reset on.
+@see @ref arrayAppend()
+*/
+class ArenaAllocator {
+    public:
+        /**
+         * @brief Constructor
+         * @param blockSize     Size of a memory block in bytes
+         *
+         * No memory is allocated until the first array is requested.
+         */
+        explicit ArenaAllocator(std::size_t blockSize = 65536): _blockSize{blockSize}, _first{nullptr}, _current{nullptr} {}
+
+        /** @brief Copying is not allowed */
+        ArenaAllocator(const ArenaAllocator&) = delete;
+
+        /** @brief Moving is not allowed */
+        ArenaAllocator(ArenaAllocator&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Deletes all memory blocks that don't have any live arrays, the
+         * remaining ones are deleted together with their last array.
+         */
+        ~ArenaAllocator() { releaseBlocks(false); }
+
+        /** @brief Copying is not allowed */
+        ArenaAllocator& operator=(const ArenaAllocator&) = delete;
+
+        /** @brief Moving is not allowed */
+        ArenaAllocator& operator=(ArenaAllocator&&) = delete;
+
+        /** @brief Memory block size */
+        std::size_t blockSize() const { return _blockSize; }
+
+        /**
+         * @brief Count of memory blocks owned by the arena
+         *
+         * Doesn't include blocks detached on @ref reset() that still have
+         * live arrays.
+         */
+        std::size_t blockCount() const {
+            std::size_t count = 0;
+            for(const Implementation::ArenaBlock* block = _first; block; block = block->next) ++count;
+            return count;
+        }
+
+        /**
+         * @brief Allocate an array without initializing its contents
+         *
+         * Equivalent to @ref Array::Array(NoInitT, std::size_t), except that
+         * the memory comes from the arena. Initialize the elements using
+         * placement new, the deleter calls destructors on all of them.
+         */
+        template<class T> Array<T> allocate(NoInitT, std::size_t size) {
+            if(!size) return nullptr;
+            return Array<T>{static_cast<T*>(allocateInternal(size*sizeof(T), alignof(T))), size, Implementation::arenaDeleter<T>};
+        }
+
+        /**
+         * @brief Allocate a default-initialized array
+         *
+         * Equivalent to @ref Array::Array(DefaultInitT, std::size_t), except
+         * that the memory comes from the arena.
+         */
+        template<class T> Array<T> allocate(DefaultInitT, std::size_t size) {
+            Array<T> array = allocate<T>(NoInit, size);
+            for(T& i: array) new(&i) T;
+            return array;
+        }
+
+        /**
+         * @brief Allocate a value-initialized array
+         *
+         * Equivalent to @ref Array::Array(ValueInitT, std::size_t), except
+         * that the memory comes from the arena.
+         */
+        template<class T> Array<T> allocate(ValueInitT, std::size_t size) {
+            Array<T> array = allocate<T>(NoInit, size);
+            for(T& i: array) new(&i) T();
+            return array;
+        }
+
+        /**
+         * @brief Allocate a direct-initialized array
+         *
+         * Equivalent to @ref Array::Array(DirectInitT, std::size_t, Args...),
+         * except that the memory comes from the arena.
+         */
+        template<class T, class ...Args> Array<T> allocate(DirectInitT, std::size_t size, Args... args) {
+            Array<T> array = allocate<T>(NoInit, size);
+            for(T& i: array) new(&i) T{args...};
+            return array;
+        }
+
+        /**
+         * @brief Allocate a default-initialized array
+         *
+         * Alias to @ref allocate(DefaultInitT, std::size_t).
+         */
+        template<class T> Array<T> allocate(std::size_t size) {
+            return allocate<T>(DefaultInit, size);
+        }
+
+        /**
+         * @brief Reset the arena
+         *
+         * Makes memory of all blocks available again. Blocks dedicated to
+         * allocations larger than @ref blockSize() are deleted. Blocks that
+         * still have live arrays are detached from the arena instead and
+         * deleted together with their last array.
+         */
+        void reset() {
+            releaseBlocks(true);
+            _current = _first;
+        }
+
+    private:
+        void* allocateInternal(std::size_t size, std::size_t alignment);
+        /* Keeps unreferenced blocks of the default size for reuse if reuse
+           is true, deletes them otherwise. Referenced blocks are detached in
+           both cases. */
+        void releaseBlocks(bool reuse);
+
+        std::size_t _blockSize;
+        /* Blocks before _current are full, the ones after are either empty
+           or dedicated to a single large allocation */
+        Implementation::ArenaBlock* _first;
+        Implementation::ArenaBlock* _current;
+};
+
+inline void* ArenaAllocator::allocateInternal(const std::size_t size, std::size_t alignment) {
+    /* The block pointer in front of the data has to be aligned as well */
+    if(alignment < alignof(Implementation::ArenaBlock*))
+        alignment = alignof(Implementation::ArenaBlock*);
+
+    /* Worst case space needed including the padding */
+    const std::size_t needed = size + sizeof(Implementation::ArenaBlock*) + alignment - 1;
+
+    /* Find a block with enough space, continuing to the next (empty) block or
+       allocating a new one if the current one is full. Allocations not
+       fitting into a block get a dedicated one, placed after the current one
+       so the remaining space in the current one is not wasted. */
+    Implementation::ArenaBlock* block = _current;
+    if(!block || block->capacity - block->used < needed) {
+        if(needed > _blockSize) {
+            block = Implementation::arenaAllocateBlock(needed);
+            if(_current) {
+                block->next = _current->next;
+                _current->next = block;
+            } else _first = _current = block;
+        } else {
+            /* Reuse a retained block if there's one, skipping full blocks
+               dedicated to large allocations. If there's none, a new block
+               is put at the end of the chain. The first block can't be a
+               dedicated one if there's no current block. */
+            Implementation::ArenaBlock* previous = _current;
+            block = _current ? _current->next : nullptr;
+            for(; block && block->capacity - block->used < needed; block = block->next)
+                previous = block;
+            if(!block) {
+                block = Implementation::arenaAllocateBlock(_blockSize);
+                if(previous) previous->next = block;
+                else _first = block;
+            }
+            _current = block;
+        }
+    }
+
+    /* Bump the pointer */
+    const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(block->data() + block->used) + sizeof(Implementation::ArenaBlock*);
+    char* const data = reinterpret_cast<char*>((begin + alignment - 1) & ~std::uintptr_t(alignment - 1));
+    block->used = data + size - block->data();
+    CORRADE_INTERNAL_ASSERT(block->used <= block->capacity);
+
+    reinterpret_cast<Implementation::ArenaBlock**>(data)[-1] = block;
+    ++block->references;
+    return data;
+}
+
+inline void ArenaAllocator::releaseBlocks(const bool reuse) {
+    Implementation::ArenaBlock** previousNext = &_first;
+    for(Implementation::ArenaBlock* block = _first, *next; block; block = next) {
+        next = block->next;
+
+        /* Keep unreferenced blocks for reuse, except for blocks dedicated
+           to large allocations, which would waste memory */
+        if(reuse && !block->references && block->capacity <= _blockSize) {
+            block->used = 0;
+            *previousNext = block;
+            previousNext = &block->next;
+            continue;
+        }
+
+        /* Detach referenced blocks and delete the rest */
+        block->next = nullptr;
+        if(block->references) block->orphaned = true;
+        else Implementation::arenaDeleteBlock(block);
+    }
+
+    *previousNext = nullptr;
+}
+
+}}
+
+#endif
@@ -29,6 +29,9 @@
  * @brief Class @ref Corrade::Containers::Array
  */
 
+#include <cstdint>
+#include <cstring>
+#include <new>
 #include <type_traits>
 #include <utility>
 
@@ -48,6 +51,26 @@ namespace Implementation {
             it->~T();
         delete[] reinterpret_cast<char*>(data);
     }
+
+    /* Over-allocates by the alignment and stores the original pointer right
+       in front of the aligned data, so the deleter doesn't need to know the
+       alignment */
+    template<class T> T* alignedAllocate(std::size_t size, std::size_t alignment) {
+        char* const memory = new char[size*sizeof(T) + sizeof(char*) + alignment - 1];
+        const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(memory) + sizeof(char*);
+        char* const data = reinterpret_cast<char*>((begin + alignment - 1) & ~std::uintptr_t(alignment - 1));
+        std::memcpy(data - sizeof(char*), &memory, sizeof(char*));
+        return reinterpret_cast<T*>(data);
+    }
+
+    template<class T> void alignedDeleter(T* data, std::size_t size) {
+        if(!data) return;
+        for(T *it = data, *end = data + size; it != end; ++it)
+            it->~T();
+        char* memory;
+        std::memcpy(&memory, reinterpret_cast<char*>(data) - sizeof(char*), sizeof(char*));
+        delete[] memory;
+    }
 }
 
 /**
@@ -62,6 +85,28 @@ template<class T> void defaultDeleter(T* data, std::size_t size) {
     delete[] data;
 }
 
+namespace Implementation {
+    /* Empty arrays use defaultDeleter() with function pointer deleter types
+       it can be instantiated for (taking the element type, possibly
+       differently cv-qualified), custom deleter classes are
+       default-constructed instead. Other deleter types (such as unrelated
+       function pointers) would be value-initialized to a null pointer that
+       the destructor then calls, so these can't be default-constructed. */
+    template<class T, class D, class = void> struct DefaultDeleter {
+        static D value() {
+            static_assert(std::is_class<D>::value, "only deleter classes and function pointers matching defaultDeleter() can be default-constructed");
+            return D{};
+        }
+    };
+    template<class T, class D> struct DefaultDeleter<T, D, typename std::enable_if<std::is_class<D>::value>::type> {
+        static D value() { return D{}; }
+    };
+    template<class T, class U> struct DefaultDeleter<T, void(*)(U*, std::size_t), typename std::enable_if<std::is_same<typename std::remove_cv<T>::type, typename std::remove_cv<U>::type>::value>::type> {
+        typedef void(*Type)(U*, std::size_t);
+        static Type value() { return defaultDeleter<U>; }
+    };
+}
+
 /**
 @brief Array wrapper with size information
 @tparam T   Element type
@@ -103,6 +148,11 @@ is possible to initialize the array in a different way using so-called *tags*:
 -   @ref Array(NoInitT, std::size_t) does not initialize anything and you need
     to call the constructor on all elements manually using placement new,
     `std::uninitialized_copy` or similar. This is the dangerous option.
+-   @ref Array(AlignedInitT<alignment>, std::size_t) allocates the memory
+    aligned to given boundary and default-initializes it,
+    @ref Array(AlignedInitT<alignment>, ValueInitT, std::size_t) additionally
+    zero-initializes trivial types. Useful for SIMD code or for avoiding
+    false sharing between threads.
 
 Example:
 @code
@@ -126,6 +176,9 @@ struct Foo {
 Containers::Array<Foo> d{Containers::NoInit, 5};
 int index = 0;
 for(Foo& f: d) new(&f) Foo(index++);
+
+// 1024 floats aligned to 64 bytes
+Containers::Array<float> e{Containers::AlignedInit<64>(), 1024};
 @endcode
 
 ## Wrapping externally allocated arrays
@@ -166,6 +219,23 @@ char* data = reinterpret_cast<char*>(glMapNamedBuffer(buffer, GL_READ_WRITE));
 Containers::Array<char, UnmapBuffer> array{data, bufferSize, UnmapBuffer{buffer}};
 @endcode
 
+For allocating many short-lived arrays, @ref ArenaAllocator hands out arrays
+with the default deleter type from large memory blocks that are reclaimed all
+at once.
+
+## Growable arrays
+
+The array size is fixed by default. Functions in @ref GrowableArray.h such as
+@ref arrayAppend(), @ref arrayReserve() or @ref arrayResize() turn the array
+into a growable one by switching to an allocator that keeps track of the
+capacity. The result is still an ordinary @ref Array with the default deleter
+type, so it can be returned and passed around without copying the data:
+@code
+Containers::Array<int> a;
+for(int i = 0; i != 100; ++i)
+    Containers::arrayAppend(a, i*i); // amortized constant time
+@endcode
+
 @todo Something like ArrayTuple to create more than one array with single
     allocation and proper alignment for each type? How would non-POD types be
     constructed in that? Will that be useful in more than one place?
@@ -199,21 +269,26 @@ class Array {
         }
         #endif
 
-        /** @brief Conversion from nullptr */
+        /**
+         * @brief Conversion from nullptr
+         *
+         * Custom deleter types are default-constructed.
+         */
         #ifdef DOXYGEN_GENERATING_OUTPUT
         /*implicit*/ Array(std::nullptr_t) noexcept:
         #else
         template<class U, class V = typename std::enable_if<std::is_same<std::nullptr_t, U>::value>::type> /*implicit*/ Array(U) noexcept:
         #endif
-            _data{nullptr}, _size{0}, _deleter{defaultDeleter} {}
+            _data{nullptr}, _size{0}, _deleter(Implementation::DefaultDeleter<T, D>::value()) {}
 
         /**
          * @brief Default constructor
          *
          * Creates zero-sized array. Move array with nonzero size onto the
-         * instance to make it useful.
+         * instance to make it useful. Custom deleter types are
+         * default-constructed.
          */
-        /*implicit*/ Array() noexcept: _data(nullptr), _size(0), _deleter{defaultDeleter} {}
+        /*implicit*/ Array() noexcept: _data(nullptr), _size(0), _deleter(Implementation::DefaultDeleter<T, D>::value()) {}
 
         /**
          * @brief Construct default-initialized array
@@ -257,6 +332,30 @@ class Array {
          */
         explicit Array(NoInitT, std::size_t size): _data{size ? reinterpret_cast<T*>(new char[size*sizeof(T)]) : nullptr}, _size{size}, _deleter{Implementation::noInitDeleter} {}
 
+        /**
+         * @brief Construct default-initialized array with aligned memory
+         *
+         * Creates array of given size with the data aligned to
+         * @p alignment bytes, which has to be at least the alignment of
+         * @p T. The contents are default-initialized (i.e. builtin types are
+         * not initialized). If the size is zero, no allocation is done.
+         * @attention Similarly to @ref Array(NoInitT, std::size_t), the data
+         *      are allocated as `char` array and the array has a custom
+         *      deleter that calls destructor on all elements and deallocates
+         *      the whole allocation.
+         * @see @ref AlignedInit(), @ref deleter()
+         */
+        template<std::size_t alignment> explicit Array(AlignedInitT<alignment>, std::size_t size);
+
+        /**
+         * @brief Construct value-initialized array with aligned memory
+         *
+         * Same as @ref Array(AlignedInitT<alignment>, std::size_t), but the
+         * contents are value-initialized (i.e. builtin types are
+         * zero-initialized).
+         */
+        template<std::size_t alignment> explicit Array(AlignedInitT<alignment>, ValueInitT, std::size_t size);
+
         /**
          * @brief Construct direct-initialized array
          *
@@ -470,6 +569,18 @@ template<class T, class D> template<class ...Args> Array<T, D>::Array(DirectInit
         new(_data + i) T{args...};
 }
 
+template<class T, class D> template<std::size_t alignment> Array<T, D>::Array(AlignedInitT<alignment>, std::size_t size): _data{size ? Implementation::alignedAllocate<T>(size, alignment) : nullptr}, _size{size}, _deleter{Implementation::alignedDeleter} {
+    static_assert(alignment >= alignof(T), "alignment can't be smaller than alignment of the type");
+    for(std::size_t i = 0; i != size; ++i)
+        new(_data + i) T;
+}
+
+template<class T, class D> template<std::size_t alignment> Array<T, D>::Array(AlignedInitT<alignment>, ValueInitT, std::size_t size): _data{size ? Implementation::alignedAllocate<T>(size, alignment) : nullptr}, _size{size}, _deleter{Implementation::alignedDeleter} {
+    static_assert(alignment >= alignof(T), "alignment can't be smaller than alignment of the type");
+    for(std::size_t i = 0; i != size; ++i)
+        new(_data + i) T();
+}
+
 template<class T, class D> inline Array<T, D>& Array<T, D>::operator=(Array<T, D>&& other) noexcept {
     using std::swap;
     swap(_data, other._data);
@@ -67,7 +67,7 @@ Containers::ArrayView<const int> c{data2, 3};
     includes also the zero-terminator (thus in case of `"hello"` the size would
     be 6, not 5, as one might expect).
 
-@see @ref ArrayView<const void>, @ref StaticArrayView
+@see @ref ArrayView<const void>, @ref StaticArrayView, @ref StridedArrayView
 @todo What was the reason for no const-correctness at all?
 */
 template<class T> class ArrayView {
@@ -38,12 +38,18 @@
 
 namespace Corrade { namespace Containers {
 
+class ArenaAllocator;
 template<class T, class = void(*)(T*, std::size_t)> class Array;
 template<class> class ArrayView;
+template<class> struct ArrayNewAllocator;
+template<class> struct ArrayMallocAllocator;
 #ifdef CORRADE_BUILD_DEPRECATED
 template<class T> using ArrayReference CORRADE_DEPRECATED_ALIAS("use ArrayView.h and ArrayView instead") = ArrayView<T>;
 #endif
 template<std::size_t, class> class StaticArrayView;
+template<class T, unsigned = 1> class StridedArrayView;
+template<unsigned, class> class StridedDimensions;
+template<class, unsigned> class StridedIterator;
 
 template<class T, typename std::underlying_type<T>::type fullValue = typename std::underlying_type<T>::type(~0)> class EnumSet;
 template<class> class LinkedList;
@@ -0,0 +1,502 @@
+#ifndef Corrade_Containers_GrowableArray_h
+#define Corrade_Containers_GrowableArray_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::ArrayNewAllocator, @ref Corrade::Containers::ArrayMallocAllocator, alias @ref Corrade::Containers::ArrayAllocator, function @ref Corrade::Containers::arrayIsGrowable(), @ref Corrade::Containers::arrayCapacity(), @ref Corrade::Containers::arrayReserve(), @ref Corrade::Containers::arrayResize(), @ref Corrade::Containers::arrayAppend(), @ref Corrade::Containers::arrayRemoveSuffix(), @ref Corrade::Containers::arrayShrink()
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "Corrade/Containers/Array.h"
+#include "Corrade/Utility/Assert.h"
+
+namespace Corrade { namespace Containers {
+
+namespace Implementation {
+    /* std::is_trivially_copyable is not in libstdc++ before GCC 5 */
+    template<class T> struct IsTriviallyCopyable: std::integral_constant<bool,
+        #if defined(__GNUC__) && !defined(__clang__) && __GNUC__ < 5
+        __has_trivial_copy(T) && __has_trivial_destructor(T)
+        #else
+        std::is_trivially_copyable<T>::value
+        #endif
+        > {};
+
+    /* Growable allocations store the capacity in front of the data, padded
+       so the data stay aligned for T */
+    template<class T> struct ArrayAllocationOffset: std::integral_constant<std::size_t, (alignof(T) < sizeof(std::size_t) ? sizeof(std::size_t) : alignof(T))> {};
+
+    /* Doubling the capacity, but allocating at least 16 bytes for small
+       types so the first few appends don't reallocate every time */
+    template<class T> std::size_t arrayGrowth(const std::size_t capacity, const std::size_t desired) {
+        const std::size_t grown = capacity ? capacity*2 : (sizeof(T) < 16 ? 16/sizeof(T) : 1);
+        return desired > grown ? desired : grown;
+    }
+
+    /* Moves count elements into uninitialized memory. Trivially copyable
+       types are just copied. */
+    template<class T> void arrayMoveConstruct(T* src, T* dst, std::size_t count, std::true_type) {
+        if(count) std::memcpy(dst, src, count*sizeof(T));
+    }
+    template<class T> void arrayMoveConstruct(T* src, T* dst, std::size_t count, std::false_type) {
+        for(T* end = src + count; src != end; ++src, ++dst)
+            new(dst) T(std::move(*src));
+    }
+    template<class T> void arrayMoveConstruct(T* src, T* dst, std::size_t count) {
+        arrayMoveConstruct(src, dst, count, IsTriviallyCopyable<T>{});
+    }
+
+    template<class T> void arrayDestruct(T* begin, T* end) {
+        for(; begin != end; ++begin) begin->~T();
+    }
+
+    /* Replaces array contents without calling the deleter on the previous
+       ones, which are expected to be taken over by the caller */
+    template<class T> void arrayRewrap(Array<T>& array, T* data, std::size_t size, void(*deleter)(T*, std::size_t)) {
+        array.release();
+        array = Array<T>{data, size, deleter};
+    }
+}
+
+/**
+@brief New-based allocator for growable arrays
+@tparam T   Element type
+
+Allocates the memory as a `char` array using `operator new[]` and constructs
+the elements in it with placement new. Reallocation always allocates a new
+block, move-constructs the elements into it and destroys the originals, so it
+works with any movable type. The capacity is stored in front of the data.
+@see @ref ArrayMallocAllocator, @ref ArrayAllocator, @ref arrayAppend()
+*/
+template<class T> struct ArrayNewAllocator {
+    typedef T Type; /**< @brief Element type */
+
+    enum: std::size_t {
+        /** Offset of the data from the allocation begin */
+        AllocationOffset = Implementation::ArrayAllocationOffset<T>::value
+    };
+
+    /**
+     * @brief Allocate array for given capacity
+     *
+     * The returned memory is not initialized. Expects that the allocation
+     * size doesn't overflow.
+     */
+    static T* allocate(std::size_t capacity) {
+        CORRADE_ASSERT(capacity <= (~std::size_t{} - AllocationOffset)/sizeof(T),
+            "Containers::ArrayNewAllocator::allocate(): can't allocate" << capacity << "elements", nullptr);
+        char* const memory = new char[capacity*sizeof(T) + AllocationOffset];
+        *reinterpret_cast<std::size_t*>(memory) = capacity;
+        return reinterpret_cast<T*>(memory + AllocationOffset);
+    }
+
+    /**
+     * @brief Reallocate array to given capacity
+     *
+     * Moves first @p prevSize elements of @p array to a new allocation of
+     * @p newCapacity elements, destroys the originals and updates
+     * @p array to point to the new allocation.
+     */
+    static void reallocate(T*& array, std::size_t prevSize, std::size_t newCapacity) {
+        T* const newArray = allocate(newCapacity);
+        Implementation::arrayMoveConstruct(array, newArray, prevSize);
+        Implementation::arrayDestruct(array, array + prevSize);
+        deallocate(array);
+        array = newArray;
+    }
+
+    /**
+     * @brief Deallocate array
+     *
+     * Doesn't call any destructors. Does nothing if @p data is `nullptr`.
+     */
+    static void deallocate(T* data) {
+        if(data) delete[] (reinterpret_cast<char*>(data) - AllocationOffset);
+    }
+
+    /**
+     * @brief Capacity to grow to
+     *
+     * Returns a capacity of at least @p desired elements for an array with
+     * capacity of @p capacity elements, growing geometrically.
+     */
+    static std::size_t grow(std::size_t capacity, std::size_t desired) {
+        return Implementation::arrayGrowth<T>(capacity, desired);
+    }
+
+    /** @brief Array capacity */
+    static std::size_t capacity(const T* array) {
+        return *reinterpret_cast<const std::size_t*>(reinterpret_cast<const char*>(array) - AllocationOffset);
+    }
+
+    /**
+     * @brief Array deleter
+     *
+     * Destroys first @p size elements and deallocates the array. Used as
+     * the @ref Array deleter, identifies growable arrays.
+     */
+    static void deleter(T* data, std::size_t size) {
+        Implementation::arrayDestruct(data, data + size);
+        deallocate(data);
+    }
+};
+
+/**
+@brief Malloc-based allocator for growable arrays
+@tparam T   Element type, has to be trivially copyable
+
+Allocates the memory using @ref std::malloc() and grows it using
+@ref std::realloc(), which can often extend the allocation in place without
+copying anything. The capacity is stored in front of the data.
+@see @ref ArrayNewAllocator, @ref ArrayAllocator, @ref arrayAppend()
+*/
+template<class T> struct ArrayMallocAllocator {
+    static_assert(Implementation::IsTriviallyCopyable<T>::value,
+        "only trivially copyable types are usable with this allocator");
+
+    typedef T Type; /**< @brief Element type */
+
+    enum: std::size_t {
+        /** Offset of the data from the allocation begin */
+        AllocationOffset = Implementation::ArrayAllocationOffset<T>::value
+    };
+
+    /** @copydoc ArrayNewAllocator::allocate() */
+    static T* allocate(std::size_t capacity) {
+        CORRADE_ASSERT(capacity <= (~std::size_t{} - AllocationOffset)/sizeof(T),
+            "Containers::ArrayMallocAllocator::allocate(): can't allocate" << capacity << "elements", nullptr);
+        char* const memory = static_cast<char*>(std::malloc(capacity*sizeof(T) + AllocationOffset));
+        CORRADE_INTERNAL_ASSERT(memory);
+        *reinterpret_cast<std::size_t*>(memory) = capacity;
+        return reinterpret_cast<T*>(memory + AllocationOffset);
+    }
+
+    /**
+     * @brief Reallocate array to given capacity
+     *
+     * Calls @ref std::realloc() on the allocation and updates @p array to
+     * point to the result. @p prevSize is ignored, as the whole allocation
+     * is preserved. Expects that the allocation size doesn't overflow.
+     */
+    static void reallocate(T*& array, std::size_t prevSize, std::size_t newCapacity) {
+        static_cast<void>(prevSize);
+        CORRADE_ASSERT(newCapacity <= (~std::size_t{} - AllocationOffset)/sizeof(T),
+            "Containers::ArrayMallocAllocator::reallocate(): can't allocate" << newCapacity << "elements", );
+        char* const memory = static_cast<char*>(std::realloc(reinterpret_cast<char*>(array) - AllocationOffset, newCapacity*sizeof(T) + AllocationOffset));
+        CORRADE_INTERNAL_ASSERT(memory);
+        *reinterpret_cast<std::size_t*>(memory) = newCapacity;
+        array = reinterpret_cast<T*>(memory + AllocationOffset);
+    }
+
+    /** @copydoc ArrayNewAllocator::deallocate() */
+    static void deallocate(T* data) {
+        if(data) std::free(reinterpret_cast<char*>(data) - AllocationOffset);
+    }
+
+    /** @copydoc ArrayNewAllocator::grow() */
+    static std::size_t grow(std::size_t capacity, std::size_t desired) {
+        return Implementation::arrayGrowth<T>(capacity, desired);
+    }
+
+    /** @copydoc ArrayNewAllocator::capacity() */
+    static std::size_t capacity(const T* array) {
+        return *reinterpret_cast<const std::size_t*>(reinterpret_cast<const char*>(array) - AllocationOffset);
+    }
+
+    /**
+     * @brief Array deleter
+     *
+     * Deallocates the array, @p size is ignored as the elements don't need
+     * to be destroyed. Used as the @ref Array deleter, identifies growable
+     * arrays.
+     */
+    static void deleter(T* data, std::size_t size) {
+        static_cast<void>(size);
+        deallocate(data);
+    }
+};
+
+/**
+@brief Default allocator for growable arrays
+
+@ref ArrayMallocAllocator for trivially copyable types, @ref ArrayNewAllocator
+otherwise.
+*/
+template<class T> using ArrayAllocator = typename std::conditional<Implementation::IsTriviallyCopyable<T>::value, ArrayMallocAllocator<T>, ArrayNewAllocator<T>>::type;
+
+/**
+@brief Whether an array is growable
+
+Returns `true` if the array deleter is @ref ArrayNewAllocator::deleter() "Allocator::deleter()",
+`false` otherwise. Growable arrays are created by the first @ref arrayAppend(),
+@ref arrayReserve(), @ref arrayResize() or @ref arrayRemoveSuffix() call on
+any @ref Array with the default deleter type.
+
+Note that the deleter function pointers can differ between shared libraries
+on some platforms, in which case an array grown in one library is not
+recognized as growable in another and gets reallocated on the next growth.
+@see @ref arrayCapacity()
+*/
+template<class T, class Allocator = ArrayAllocator<T>> bool arrayIsGrowable(const Array<T>& array) {
+    return array.deleter() == Allocator::deleter;
+}
+
+/**
+@brief Array capacity
+
+For growable arrays returns the count of elements that fit into the current
+allocation, for other arrays the array size.
+@see @ref arrayIsGrowable(), @ref arrayReserve()
+*/
+template<class T, class Allocator = ArrayAllocator<T>> std::size_t arrayCapacity(const Array<T>& array) {
+    return array.data() && arrayIsGrowable<T, Allocator>(array) ? Allocator::capacity(array.data()) : array.size();
+}
+
+/**
+@brief Reserve given capacity in an array
+@return New capacity of the array
+
+If the capacity is already large enough, does nothing. Otherwise reallocates
+the array to exactly @p capacity elements, making it growable if it wasn't
+already. The size of the array is not changed.
+@see @ref arrayCapacity(), @ref arrayResize()
+*/
+template<class T, class Allocator = ArrayAllocator<T>> std::size_t arrayReserve(Array<T>& array, const std::size_t capacity) {
+    const std::size_t currentCapacity = arrayCapacity<T, Allocator>(array);
+    if(currentCapacity >= capacity) return currentCapacity;
+
+    const std::size_t size = array.size();
+    T* data;
+    if(array.data() && arrayIsGrowable<T, Allocator>(array)) {
+        data = array.data();
+        Allocator::reallocate(data, size, capacity);
+    } else {
+        data = Allocator::allocate(capacity);
+        Implementation::arrayMoveConstruct(array.data(), data, size);
+
+        /* The original deleter destroys the moved-from elements */
+        Array<T> original = std::move(array);
+    }
+
+    Implementation::arrayRewrap(array, data, size, Allocator::deleter);
+    return capacity;
+}
+
+namespace Implementation {
+
+/* Grows the array by count elements, returning pointer to the first of them.
+   The new elements are not constructed. */
+template<class T, class Allocator> T* arrayGrowBy(Array<T>& array, const std::size_t count) {
+    const std::size_t size = array.size();
+    const std::size_t desired = size + count;
+    T* data;
+    if(array.data() && arrayIsGrowable<T, Allocator>(array)) {
+        data = array.data();
+        const std::size_t capacity = Allocator::capacity(data);
+        if(capacity < desired)
+            Allocator::reallocate(data, size, Allocator::grow(capacity, desired));
+    } else {
+        data = Allocator::allocate(Allocator::grow(size, desired));
+        arrayMoveConstruct(array.data(), data, size);
+
+        /* The original deleter destroys the moved-from elements */
+        Array<T> original = std::move(array);
+    }
+
+    arrayRewrap(array, data, desired, Allocator::deleter);
+    return data + size;
+}
+
+}
+
+/**
+@brief Remove elements from the end of an array
+@param array        Array
+@param count        Count of elements to remove
+
+Destroys the last @p count elements. The capacity is kept, so subsequent
+@ref arrayAppend() calls don't need to allocate. If the array is not growable,
+it's reallocated to a growable one first. Expects that @p count is not larger
+than the array size.
+@see @ref arrayResize(), @ref arrayShrink()
+*/
+template<class T, class Allocator = ArrayAllocator<T>> void arrayRemoveSuffix(Array<T>& array, const std::size_t count) {
+    CORRADE_ASSERT(count <= array.size(),
+        "Containers::arrayRemoveSuffix(): can't remove" << count << "elements from an array of" << array.size(), );
+    if(!count) return;
+
+    const std::size_t size = array.size() - count;
+    T* data;
+    if(array.data() && arrayIsGrowable<T, Allocator>(array)) {
+        data = array.data();
+        Implementation::arrayDestruct(data + size, data + array.size());
+    } else {
+        data = Allocator::allocate(size);
+        Implementation::arrayMoveConstruct(array.data(), data, size);
+
+        /* The original deleter destroys the moved-from and removed
+           elements */
+        Array<T> original = std::move(array);
+    }
+
+    Implementation::arrayRewrap(array, data, size, Allocator::deleter);
+}
+
+/**
+@brief Resize an array without initializing the new elements
+@param array        Array
+@param size         New size
+
+If the array grows, it's made growable and the capacity is increased
+geometrically, so repeated resizing by small amounts is amortized constant
+time. The new elements are not initialized, construct them using placement
+new. If the array shrinks, behaves like @ref arrayRemoveSuffix().
+@see @ref arrayReserve(), @ref arrayCapacity()
+*/
+template<class T, class Allocator = ArrayAllocator<T>> void arrayResize(Array<T>& array, NoInitT, const std::size_t size) {
+    if(size < array.size()) arrayRemoveSuffix<T, Allocator>(array, array.size() - size);
+    else if(size > array.size()) Implementation::arrayGrowBy<T, Allocator>(array, size - array.size());
+}
+
+/**
+@brief Resize an array and default-initialize the new elements
+
+Same as @ref arrayResize(Array<T>&, NoInitT, std::size_t), but the new
+elements are default-initialized (i.e. builtin types are not initialized).
+*/
+template<class T, class Allocator = ArrayAllocator<T>> void arrayResize(Array<T>& array, DefaultInitT, const std::size_t size) {
+    const std::size_t prevSize = array.size();
+    arrayResize<T, Allocator>(array, NoInit, size);
+    for(T *it = array.data() + prevSize, *end = array.end(); it < end; ++it)
+        new(it) T;
+}
+
+/**
+@brief Resize an array and value-initialize the new elements
+
+Same as @ref arrayResize(Array<T>&, NoInitT, std::size_t), but the new
+elements are value-initialized (i.e. builtin types are zeroed out).
+*/
+template<class T, class Allocator = ArrayAllocator<T>> void arrayResize(Array<T>& array, ValueInitT, const std::size_t size) {
+    const std::size_t prevSize = array.size();
+    arrayResize<T, Allocator>(array, NoInit, size);
+    for(T *it = array.data() + prevSize, *end = array.end(); it < end; ++it)
+        new(it) T();
+}
+
+/**
+@brief Resize an array and direct-initialize the new elements
+
+Same as @ref arrayResize(Array<T>&, NoInitT, std::size_t), but the new
+elements are constructed using @p args. Similarly to
+@ref Array::Array(DirectInitT, std::size_t, Args...), the arguments are not
+forwarded.
+*/
+template<class T, class Allocator = ArrayAllocator<T>, class ...Args> void arrayResize(Array<T>& array, DirectInitT, const std::size_t size, Args... args) {
+    const std::size_t prevSize = array.size();
+    arrayResize<T, Allocator>(array, NoInit, size);
+    for(T *it = array.data() + prevSize, *end = array.end(); it < end; ++it)
+        new(it) T{args...};
+}
+
+/**
+@brief Resize an array
+
+Alias to @ref arrayResize(Array<T>&, DefaultInitT, std::size_t), same as
+@ref Array::Array(std::size_t) is an alias to
+@ref Array::Array(DefaultInitT, std::size_t).
+*/
+template<class T, class Allocator = ArrayAllocator<T>> void arrayResize(Array<T>& array, const std::size_t size) {
+    arrayResize<T, Allocator>(array, DefaultInit, size);
+}
+
+/**
+@brief Append an element to an array
+@return Reference to the appended element
+
+If the array is not growable or its capacity is exhausted, it's reallocated
+with the capacity increased geometrically, so appending is amortized constant
+time. The @p value can't reference an element of @p array itself.
+
+The default @ref ArrayAllocator can be overriden by specifying the allocator
+explicitly:
+@code
+Containers::Array<int> array;
+Containers::arrayAppend<int, Containers::ArrayNewAllocator<int>>(array, 5);
+@endcode
+
+@see @ref arrayReserve(), @ref arrayIsGrowable()
+*/
+template<class T, class Allocator = ArrayAllocator<T>> T& arrayAppend(Array<T>& array, const typename std::common_type<T>::type& value) {
+    return *new(Implementation::arrayGrowBy<T, Allocator>(array, 1)) T(value);
+}
+
+/** @overload */
+template<class T, class Allocator = ArrayAllocator<T>> T& arrayAppend(Array<T>& array, typename std::common_type<T>::type&& value) {
+    return *new(Implementation::arrayGrowBy<T, Allocator>(array, 1)) T(std::move(value));
+}
+
+/**
+@brief Append a list of elements to an array
+@return View on the appended elements
+
+Copies all elements from @p values to the end of the array, see
+@ref arrayAppend(Array<T>&, const typename std::common_type<T>::type&) for
+more information. The @p values can't be a view on @p array itself.
+*/
+template<class T, class Allocator = ArrayAllocator<T>> ArrayView<T> arrayAppend(Array<T>& array, const typename std::common_type<ArrayView<const T>>::type values) {
+    T* const it = Implementation::arrayGrowBy<T, Allocator>(array, values.size());
+    for(std::size_t i = 0; i != values.size(); ++i)
+        new(it + i) T(values[i]);
+    return {it, values.size()};
+}
+
+/**
+@brief Convert a growable array back to a default one
+
+Reallocates a growable array to an array of exactly its size using
+@ref Array::Array(NoInitT, std::size_t) and moves the elements to it, making
+the array usable from code that doesn't know about the growable allocators.
+Does nothing if the array is not growable.
+@see @ref arrayIsGrowable()
+*/
+template<class T, class Allocator = ArrayAllocator<T>> void arrayShrink(Array<T>& array) {
+    if(!arrayIsGrowable<T, Allocator>(array)) return;
+
+    Array<T> shrinked{NoInit, array.size()};
+    Implementation::arrayMoveConstruct(array.data(), shrinked.data(), array.size());
+
+    /* The allocator deleter destroys the moved-from elements */
+    Array<T> original = std::move(array);
+    array = std::move(shrinked);
+}
+
+}}
+
+#endif
@@ -0,0 +1,551 @@
+#ifndef Corrade_Containers_StridedArrayView_h
+#define Corrade_Containers_StridedArrayView_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Containers::StridedArrayView, @ref Corrade::Containers::StridedDimensions, @ref Corrade::Containers::StridedIterator
+ */
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include "Corrade/Containers/ArrayView.h"
+#include "Corrade/Utility/Assert.h"
+
+namespace Corrade { namespace Containers {
+
+/**
+@brief Multi-dimensional size and stride
+
+Size and stride of a multi-dimensional @ref StridedArrayView. One-dimensional
+views use plain @ref std::size_t and @ref std::ptrdiff_t instead.
+*/
+template<unsigned dimensions, class T> class StridedDimensions {
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * All values are zero.
+         */
+        constexpr /*implicit*/ StridedDimensions() noexcept: _data{} {}
+
+        /**
+         * @brief Constructor
+         *
+         * Expects exactly @p dimensions values.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        template<class ...Args> constexpr /*implicit*/ StridedDimensions(T first, Args... next) noexcept;
+        #else
+        template<class ...Args, class = typename std::enable_if<sizeof...(Args) + 1 == dimensions>::type> constexpr /*implicit*/ StridedDimensions(T first, Args... next) noexcept: _data{first, T(next)...} {}
+        #endif
+
+        /**
+         * @brief Conversion to scalar
+         *
+         * Enabled only for one-dimensional values.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        constexpr /*implicit*/ operator T() const;
+        #else
+        template<unsigned d = dimensions, class = typename std::enable_if<d == 1>::type> constexpr /*implicit*/ operator T() const { return _data[0]; }
+        #endif
+
+        /** @brief Equality comparison */
+        bool operator==(const StridedDimensions<dimensions, T>& other) const {
+            for(unsigned i = 0; i != dimensions; ++i)
+                if(_data[i] != other._data[i]) return false;
+            return true;
+        }
+
+        /** @brief Non-equality comparison */
+        bool operator!=(const StridedDimensions<dimensions, T>& other) const {
+            return !operator==(other);
+        }
+
+        /** @brief Value at given dimension */
+        T& operator[](std::size_t i) { return _data[i]; }
+        constexpr T operator[](std::size_t i) const { return _data[i]; } /**< @overload */
+
+    private:
+        T _data[dimensions];
+};
+
+namespace Implementation {
+    /* Element of a multi-dimensional view is a view with one dimension
+       less, element of a one-dimensional view is a reference */
+    template<unsigned dimensions, class T> struct StridedElement {
+        typedef StridedArrayView<T, dimensions - 1> Type;
+
+        template<class ArithmeticType> static Type get(ArithmeticType* data, const StridedDimensions<dimensions, std::size_t>& size, const StridedDimensions<dimensions, std::ptrdiff_t>& stride) {
+            StridedDimensions<dimensions - 1, std::size_t> nextSize;
+            StridedDimensions<dimensions - 1, std::ptrdiff_t> nextStride;
+            for(unsigned i = 1; i != dimensions; ++i) {
+                nextSize[i - 1] = size[i];
+                nextStride[i - 1] = stride[i];
+            }
+            return Type{nextSize, nextStride, data};
+        }
+    };
+
+    template<class T> struct StridedElement<1, T> {
+        typedef T& Type;
+
+        template<class ArithmeticType> static T& get(ArithmeticType* data, const StridedDimensions<1, std::size_t>&, const StridedDimensions<1, std::ptrdiff_t>&) {
+            return *reinterpret_cast<T*>(data);
+        }
+    };
+}
+
+/**
+@brief Strided array view
+
+Immutable wrapper around a range of data with a byte stride between the
+elements, which makes it possible to access a single member of an array of
+structures or a single attribute of an interleaved buffer without copying it
+out first. Similarly to @ref ArrayView this class doesn't do any memory
+management. One-dimensional views are implicitly constructible from
+@ref ArrayView, @ref StaticArrayView and fixed-size arrays, with the stride
+being equal to the type size. If @p T is `const` type, the view is implicitly
+constructible also from views of non-const types.
+
+Usage example:
+@code
+struct Vertex {
+    float position[3];
+    int id;
+};
+Containers::ArrayView<Vertex> vertices;
+
+// View on the IDs only
+Containers::StridedArrayView<int> ids{vertices, &vertices.begin()->id,
+    vertices.size(), sizeof(Vertex)};
+for(int& id: ids) id = 0;
+@endcode
+
+The constructor checks that the view fits into the data passed in the first
+argument. The stride can be negative as well, in that case the elements are
+iterated in reverse.
+
+## Multi-dimensional views
+
+With @p dimensions larger than `1`, size and stride are specified for each
+dimension using @ref StridedDimensions and @ref operator[]() returns a view
+with one dimension less. Apart from slicing in the first dimension with
+@ref slice(std::size_t, std::size_t) const, the view can be sliced in all
+dimensions at once and its dimensions can be swapped with @ref transposed(),
+both without touching the data:
+@code
+int data[12];
+
+// 4 rows of 3 columns
+Containers::StridedArrayView<int, 2> image{data, {4, 3}, {12, 4}};
+int& a = image[1][2]; // same as data[5]
+
+// 3 rows of 4 columns, a is the same as columns[2][1]
+Containers::StridedArrayView<int, 2> columns = image.transposed<0, 1>();
+
+// Rows 1 and 2 of first two columns
+Containers::StridedArrayView<int, 2> block = image.slice({1, 0}, {3, 2});
+@endcode
+
+@see @ref StridedIterator
+*/
+#ifdef DOXYGEN_GENERATING_OUTPUT
+template<class T, unsigned dimensions = 1>
+#else
+template<class T, unsigned dimensions>
+#endif
+class StridedArrayView {
+    static_assert(dimensions, "can't have a zero-dimensional view");
+
+    template<class, unsigned> friend class StridedArrayView;
+    template<unsigned, class> friend struct Implementation::StridedElement;
+
+    public:
+        typedef T Type;     /**< @brief Underlying type */
+
+        /**
+         * @brief Element type
+         *
+         * `T&` for one-dimensional views, @ref StridedArrayView with one
+         * dimension less otherwise.
+         */
+        typedef typename Implementation::StridedElement<dimensions, T>::Type ElementType;
+
+        /** @brief Type-erased data type */
+        typedef typename std::conditional<std::is_const<T>::value, const void, void>::type ErasedType;
+
+        /**
+         * @brief Size type
+         *
+         * @ref std::size_t for one-dimensional views, @ref StridedDimensions
+         * otherwise.
+         */
+        typedef typename std::conditional<dimensions == 1, std::size_t, StridedDimensions<dimensions, std::size_t>>::type Size;
+
+        /**
+         * @brief Stride type
+         *
+         * @ref std::ptrdiff_t for one-dimensional views,
+         * @ref StridedDimensions otherwise.
+         */
+        typedef typename std::conditional<dimensions == 1, std::ptrdiff_t, StridedDimensions<dimensions, std::ptrdiff_t>>::type Stride;
+
+        enum: unsigned {
+            Dimensions = dimensions /**< View dimensions */
+        };
+
+        /** @brief Conversion from `nullptr` */
+        constexpr /*implicit*/ StridedArrayView(std::nullptr_t) noexcept: _data{}, _size{}, _stride{} {}
+
+        /**
+         * @brief Default constructor
+         *
+         * Creates empty view. Copy non-empty @ref StridedArrayView onto the
+         * instance to make it useful.
+         */
+        constexpr /*implicit*/ StridedArrayView() noexcept: _data{}, _size{}, _stride{} {}
+
+        /**
+         * @brief Constructor
+         * @param data      Data containing the viewed range
+         * @param member    Pointer to the first element
+         * @param size      Element count in each dimension
+         * @param stride    Byte stride in each dimension
+         *
+         * The elements are expected to fit into @p data. The check is
+         * skipped for empty views.
+         */
+        /*implicit*/ StridedArrayView(ArrayView<const void> data, T* member, const Size& size, const Stride& stride);
+
+        /**
+         * @brief Constructor
+         *
+         * Equivalent to calling the above with the first element of @p data
+         * as @p member.
+         */
+        /*implicit*/ StridedArrayView(ArrayView<T> data, const Size& size, const Stride& stride): StridedArrayView{data, data.begin(), size, stride} {}
+
+        /**
+         * @brief Construct view on @ref ArrayView
+         *
+         * Enabled only for one-dimensional views and if `U` or `const U` is
+         * `T`. The stride is equal to the type size.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        template<class U> /*implicit*/ StridedArrayView(ArrayView<U> view) noexcept;
+        #else
+        template<class U, unsigned d = dimensions, class = typename std::enable_if<d == 1 && (std::is_same<U, T>::value || std::is_same<const U, T>::value)>::type> /*implicit*/ StridedArrayView(ArrayView<U> view) noexcept: _data{reinterpret_cast<ArithmeticType*>(view.begin())}, _size{view.size()}, _stride{std::ptrdiff_t(sizeof(T))} {}
+        #endif
+
+        /**
+         * @brief Construct view on @ref StaticArrayView
+         *
+         * Enabled only for one-dimensional views and if `U` or `const U` is
+         * `T`. The stride is equal to the type size.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        template<std::size_t size, class U> /*implicit*/ StridedArrayView(StaticArrayView<size, U> view) noexcept;
+        #else
+        template<std::size_t size, class U, unsigned d = dimensions, class = typename std::enable_if<d == 1 && (std::is_same<U, T>::value || std::is_same<const U, T>::value)>::type> /*implicit*/ StridedArrayView(StaticArrayView<size, U> view) noexcept: _data{reinterpret_cast<ArithmeticType*>(view.begin())}, _size{size}, _stride{std::ptrdiff_t(sizeof(T))} {}
+        #endif
+
+        /**
+         * @brief Construct view of fixed-size array
+         *
+         * Enabled only for one-dimensional views. The stride is equal to the
+         * type size.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        template<std::size_t size> /*implicit*/ StridedArrayView(T(&data)[size]) noexcept;
+        #else
+        template<std::size_t size, unsigned d = dimensions, class = typename std::enable_if<d == 1>::type> /*implicit*/ StridedArrayView(T(&data)[size]) noexcept: _data{reinterpret_cast<ArithmeticType*>(data)}, _size{size}, _stride{std::ptrdiff_t(sizeof(T))} {}
+        #endif
+
+        /**
+         * @brief Construct const view on non-const @ref StridedArrayView
+         *
+         * Enabled only if `const U` is `T`.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        template<class U>
+        #else
+        template<class U, class = typename std::enable_if<std::is_same<const U, T>::value>::type>
+        #endif
+        constexpr /*implicit*/ StridedArrayView(const StridedArrayView<U, dimensions>& view) noexcept: _data{view._data}, _size{view._size}, _stride{view._stride} {}
+
+        /** @brief Type-erased pointer to the first element */
+        ErasedType* data() const { return _data; }
+
+        /** @brief View size */
+        Size size() const { return _size; }
+
+        /** @brief View stride */
+        Stride stride() const { return _stride; }
+
+        /** @brief Whether the view is empty in any dimension */
+        bool empty() const {
+            for(unsigned i = 0; i != dimensions; ++i)
+                if(!_size[i]) return true;
+            return false;
+        }
+
+        /**
+         * @brief Element access
+         *
+         * No bounds checking is done, similarly to @ref ArrayView.
+         */
+        ElementType operator[](std::size_t i) const {
+            return Implementation::StridedElement<dimensions, T>::get(_data + std::ptrdiff_t(i)*_stride[0], _size, _stride);
+        }
+
+        /** @brief Iterator to first element */
+        StridedIterator<T, dimensions> begin() const;
+        StridedIterator<T, dimensions> cbegin() const { return begin(); } /**< @overload */
+
+        /** @brief Iterator to (one item after) last element */
+        StridedIterator<T, dimensions> end() const;
+        StridedIterator<T, dimensions> cend() const { return end(); } /**< @overload */
+
+        /**
+         * @brief View slice in the first dimension
+         *
+         * Both arguments are expected to be in range. Other dimensions are
+         * kept as they are.
+         */
+        StridedArrayView<T, dimensions> slice(std::size_t begin, std::size_t end) const;
+
+        /**
+         * @brief Multi-dimensional view slice
+         *
+         * Both arguments are expected to be in range in all dimensions.
+         * Enabled only for multi-dimensional views.
+         */
+        #ifdef DOXYGEN_GENERATING_OUTPUT
+        StridedArrayView<T, dimensions> slice(const Size& begin, const Size& end) const;
+        #else
+        template<unsigned d = dimensions, class = typename std::enable_if<(d > 1)>::type> StridedArrayView<T, dimensions> slice(const StridedDimensions<d, std::size_t>& begin, const StridedDimensions<d, std::size_t>& end) const {
+            return sliceInternal(begin, end);
+        }
+        #endif
+
+        /**
+         * @brief View prefix
+         *
+         * Equivalent to `data.slice(0, end)`.
+         */
+        StridedArrayView<T, dimensions> prefix(std::size_t end) const {
+            return slice(0, end);
+        }
+
+        /**
+         * @brief View suffix
+         *
+         * Equivalent to `data.slice(begin, data.size()[0])`.
+         */
+        StridedArrayView<T, dimensions> suffix(std::size_t begin) const {
+            return slice(begin, _size[0]);
+        }
+
+        /**
+         * @brief Transpose two dimensions
+         *
+         * Swaps size and stride of @p dimensionA and @p dimensionB, the data
+         * are not touched.
+         */
+        template<unsigned dimensionA, unsigned dimensionB> StridedArrayView<T, dimensions> transposed() const;
+
+    private:
+        typedef typename std::conditional<std::is_const<T>::value, const char, char>::type ArithmeticType;
+
+        constexpr explicit StridedArrayView(const StridedDimensions<dimensions, std::size_t>& size, const StridedDimensions<dimensions, std::ptrdiff_t>& stride, ArithmeticType* data) noexcept: _data{data}, _size{size}, _stride{stride} {}
+
+        StridedArrayView<T, dimensions> sliceInternal(const StridedDimensions<dimensions, std::size_t>& begin, const StridedDimensions<dimensions, std::size_t>& end) const;
+
+        ArithmeticType* _data;
+        StridedDimensions<dimensions, std::size_t> _size;
+        StridedDimensions<dimensions, std::ptrdiff_t> _stride;
+};
+
+/**
+@brief Strided array view iterator
+
+Returned by @ref StridedArrayView::begin() and @ref StridedArrayView::end(),
+iterates over the first dimension of the view. The iterators are expected to
+be compared only if they come from the same view.
+*/
+template<class T, unsigned dimensions> class StridedIterator {
+    public:
+        /** @brief Constructor */
+        explicit StridedIterator(const StridedArrayView<T, dimensions>& view, std::size_t i) noexcept: _view{view}, _i{i} {}
+
+        /** @brief Equality comparison */
+        bool operator==(const StridedIterator<T, dimensions>& other) const { return _i == other._i; }
+
+        /** @brief Non-equality comparison */
+        bool operator!=(const StridedIterator<T, dimensions>& other) const { return _i != other._i; }
+
+        /** @brief Less than comparison */
+        bool operator<(const StridedIterator<T, dimensions>& other) const { return _i < other._i; }
+
+        /** @brief Less than or equal comparison */
+        bool operator<=(const StridedIterator<T, dimensions>& other) const { return _i <= other._i; }
+
+        /** @brief Greater than comparison */
+        bool operator>(const StridedIterator<T, dimensions>& other) const { return _i > other._i; }
+
+        /** @brief Greater than or equal comparison */
+        bool operator>=(const StridedIterator<T, dimensions>& other) const { return _i >= other._i; }
+
+        /** @brief Add an offset */
+        StridedIterator<T, dimensions> operator+(std::ptrdiff_t i) const {
+            return StridedIterator<T, dimensions>{_view, _i + i};
+        }
+
+        /** @brief Subtract an offset */
+        StridedIterator<T, dimensions> operator-(std::ptrdiff_t i) const {
+            return StridedIterator<T, dimensions>{_view, _i - i};
+        }
+
+        /** @brief Iterator difference */
+        std::ptrdiff_t operator-(const StridedIterator<T, dimensions>& other) const {
+            return std::ptrdiff_t(_i - other._i);
+        }
+
+        /** @brief Add an offset and assign */
+        StridedIterator<T, dimensions>& operator+=(std::ptrdiff_t i) {
+            _i += i;
+            return *this;
+        }
+
+        /** @brief Subtract an offset and assign */
+        StridedIterator<T, dimensions>& operator-=(std::ptrdiff_t i) {
+            _i -= i;
+            return *this;
+        }
+
+        /** @brief Go to next position */
+        StridedIterator<T, dimensions>& operator++() {
+            ++_i;
+            return *this;
+        }
+
+        /** @brief Go to next position, returning the previous one */
+        StridedIterator<T, dimensions> operator++(int) {
+            return StridedIterator<T, dimensions>{_view, _i++};
+        }
+
+        /** @brief Go to previous position */
+        StridedIterator<T, dimensions>& operator--() {
+            --_i;
+            return *this;
+        }
+
+        /** @brief Go to previous position, returning the next one */
+        StridedIterator<T, dimensions> operator--(int) {
+            return StridedIterator<T, dimensions>{_view, _i--};
+        }
+
+        /** @brief Dereference */
+        typename StridedArrayView<T, dimensions>::ElementType operator*() const {
+            return _view[_i];
+        }
+
+    private:
+        StridedArrayView<T, dimensions> _view;
+        std::size_t _i;
+};
+
+template<class T, unsigned dimensions> StridedArrayView<T, dimensions>::StridedArrayView(const ArrayView<const void> data, T* const member, const Size& size, const Stride& stride): _data{reinterpret_cast<ArithmeticType*>(member)}, _size{size}, _stride{stride} {
+    #if !defined(CORRADE_NO_ASSERT) || defined(CORRADE_GRACEFUL_ASSERT)
+    /* Find the lowest and highest byte offset the view touches, relative to
+       the first element. Empty views don't touch anything. */
+    std::ptrdiff_t min{}, max{};
+    bool isEmpty = false;
+    for(unsigned i = 0; i != dimensions; ++i) {
+        if(!_size[i]) {
+            isEmpty = true;
+            break;
+        }
+
+        const std::ptrdiff_t offset = std::ptrdiff_t(_size[i] - 1)*_stride[i];
+        if(offset < 0) min += offset;
+        else max += offset;
+    }
+
+    const std::ptrdiff_t begin = reinterpret_cast<const char*>(member) - static_cast<const char*>(data.data());
+    CORRADE_ASSERT(isEmpty || (begin + min >= 0 && begin + max + std::ptrdiff_t(sizeof(T)) <= std::ptrdiff_t(data.size())),
+        "Containers::StridedArrayView: data size" << data.size() << "is not enough for given size and stride", );
+    #else
+    static_cast<void>(data);
+    #endif
+}
+
+template<class T, unsigned dimensions> inline StridedIterator<T, dimensions> StridedArrayView<T, dimensions>::begin() const {
+    return StridedIterator<T, dimensions>{*this, 0};
+}
+
+template<class T, unsigned dimensions> inline StridedIterator<T, dimensions> StridedArrayView<T, dimensions>::end() const {
+    return StridedIterator<T, dimensions>{*this, _size[0]};
+}
+
+template<class T, unsigned dimensions> StridedArrayView<T, dimensions> StridedArrayView<T, dimensions>::slice(const std::size_t begin, const std::size_t end) const {
+    StridedDimensions<dimensions, std::size_t> begins;
+    StridedDimensions<dimensions, std::size_t> ends = _size;
+    begins[0] = begin;
+    ends[0] = end;
+    return sliceInternal(begins, ends);
+}
+
+template<class T, unsigned dimensions> StridedArrayView<T, dimensions> StridedArrayView<T, dimensions>::sliceInternal(const StridedDimensions<dimensions, std::size_t>& begin, const StridedDimensions<dimensions, std::size_t>& end) const {
+    ArithmeticType* data = _data;
+    StridedDimensions<dimensions, std::size_t> size;
+    for(unsigned i = 0; i != dimensions; ++i) {
+        CORRADE_ASSERT(begin[i] <= end[i] && end[i] <= _size[i],
+            "Containers::StridedArrayView::slice(): slice out of range", nullptr);
+        data += std::ptrdiff_t(begin[i])*_stride[i];
+        size[i] = end[i] - begin[i];
+    }
+
+    return StridedArrayView<T, dimensions>{size, _stride, data};
+}
+
+template<class T, unsigned dimensions> template<unsigned dimensionA, unsigned dimensionB> StridedArrayView<T, dimensions> StridedArrayView<T, dimensions>::transposed() const {
+    static_assert(dimensionA < dimensions && dimensionB < dimensions,
+        "dimensions out of range");
+
+    StridedDimensions<dimensions, std::size_t> size = _size;
+    StridedDimensions<dimensions, std::ptrdiff_t> stride = _stride;
+    std::swap(size[dimensionA], size[dimensionB]);
+    std::swap(stride[dimensionA], stride[dimensionB]);
+    return StridedArrayView<T, dimensions>{size, stride, _data};
+}
+
+}}
+
+#endif
@@ -26,9 +26,11 @@
 */
 
 /** @file
- * @brief Tag type @ref Corrade::Containers::ValueInitT, @ref Corrade::Containers::DefaultInitT, @ref Corrade::Containers::NoInitT, @ref Corrade::Containers::DirectInitT, tag @ref Corrade::Containers::ValueInit, @ref Corrade::Containers::DefaultInit, @ref Corrade::Containers::NoInit, @ref Corrade::Containers::DirectInit
+ * @brief Tag type @ref Corrade::Containers::ValueInitT, @ref Corrade::Containers::DefaultInitT, @ref Corrade::Containers::NoInitT, @ref Corrade::Containers::DirectInitT, @ref Corrade::Containers::AlignedInitT, tag @ref Corrade::Containers::ValueInit, @ref Corrade::Containers::DefaultInit, @ref Corrade::Containers::NoInit, @ref Corrade::Containers::DirectInit, function @ref Corrade::Containers::AlignedInit()
  */
 
+#include <cstddef>
+
 namespace Corrade { namespace Containers {
 
 /**
@@ -89,6 +91,25 @@ struct DirectInitT {
     #endif
 };
 
+/**
+@brief Aligned allocation tag type
+@tparam alignment   Allocation alignment in bytes, has to be a power of two
+
+Used to distinguish construction of arrays with memory aligned to given
+boundary.
+@see @ref AlignedInit()
+*/
+/* Explicit constructor to avoid ambiguous calls when using {} */
+template<std::size_t alignment> struct AlignedInitT {
+    static_assert(alignment && !(alignment & (alignment - 1)),
+        "alignment has to be a power of two");
+
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    struct Init{};
+    constexpr explicit AlignedInitT(Init) {}
+    #endif
+};
+
 /**
 @brief Default initialization tag
 
@@ -119,6 +140,18 @@ Use for construction with direct initialization.
 */
 constexpr DirectInitT DirectInit{DirectInitT::Init{}};
 
+/**
+@brief Aligned allocation tag
+@tparam alignment   Allocation alignment in bytes, has to be a power of two
+
+Use for construction of arrays with memory aligned to given boundary. A
+function instead of a constant, as variable templates are not available in
+C++11.
+*/
+template<std::size_t alignment> constexpr AlignedInitT<alignment> AlignedInit() {
+    return AlignedInitT<alignment>{typename AlignedInitT<alignment>::Init{}};
+}
+
 }}
 
 #endif
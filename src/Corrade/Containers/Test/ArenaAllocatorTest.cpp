@@ -0,0 +1,294 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+*/
+
+#include "Corrade/Containers/ArenaAllocator.h"
+#include "Corrade/TestSuite/Tester.h"
+
+namespace Corrade { namespace Containers { namespace Test {
+
+struct ArenaAllocatorTest: TestSuite::Tester {
+    explicit ArenaAllocatorTest();
+
+    void construct();
+    void allocateNoInit();
+    void allocateDefaultInit();
+    void allocateValueInit();
+    void allocateDirectInit();
+    void allocateZeroSize();
+    void allocateAligned();
+    void allocateLarge();
+
+    void reset();
+    void resetLiveArrays();
+    void resetLarge();
+    void destroyLiveArrays();
+    void destructors();
+};
+
+ArenaAllocatorTest::ArenaAllocatorTest() {
+    addTests({&ArenaAllocatorTest::construct,
+              &ArenaAllocatorTest::allocateNoInit,
+              &ArenaAllocatorTest::allocateDefaultInit,
+              &ArenaAllocatorTest::allocateValueInit,
+              &ArenaAllocatorTest::allocateDirectInit,
+              &ArenaAllocatorTest::allocateZeroSize,
+              &ArenaAllocatorTest::allocateAligned,
+              &ArenaAllocatorTest::allocateLarge,
+
+              &ArenaAllocatorTest::reset,
+              &ArenaAllocatorTest::resetLiveArrays,
+              &ArenaAllocatorTest::resetLarge,
+              &ArenaAllocatorTest::destroyLiveArrays,
+              &ArenaAllocatorTest::destructors});
+}
+
+void ArenaAllocatorTest::construct() {
+    ArenaAllocator a;
+    CORRADE_COMPARE(a.blockSize(), 65536);
+    CORRADE_COMPARE(a.blockCount(), 0);
+
+    ArenaAllocator b{1024};
+    CORRADE_COMPARE(b.blockSize(), 1024);
+}
+
+void ArenaAllocatorTest::allocateNoInit() {
+    ArenaAllocator arena{1024};
+    Array<int> a = arena.allocate<int>(NoInit, 5);
+    Array<int> b = arena.allocate<int>(NoInit, 3);
+    CORRADE_COMPARE(arena.blockCount(), 1);
+    CORRADE_COMPARE(a.size(), 5);
+    CORRADE_COMPARE(b.size(), 3);
+
+    /* The arrays are bump-allocated one after another, only the block
+       pointer is in between */
+    CORRADE_VERIFY(b.data() > a.data() + 5);
+    CORRADE_VERIFY(reinterpret_cast<char*>(b.data()) <= reinterpret_cast<char*>(a.data() + 5) + sizeof(void*) + alignof(void*));
+
+    for(int& i: a) i = 3;
+    for(int& i: b) i = 7;
+    CORRADE_COMPARE(a[4], 3);
+    CORRADE_COMPARE(b[0], 7);
+
+    /* The array has the default deleter type, so it can go anywhere */
+    Array<int> c = std::move(a);
+    CORRADE_COMPARE(c.size(), 5);
+}
+
+void ArenaAllocatorTest::allocateDefaultInit() {
+    ArenaAllocator arena;
+    Array<int> a = arena.allocate<int>(DefaultInit, 5);
+    Array<int> b = arena.allocate<int>(5);
+    CORRADE_COMPARE(a.size(), 5);
+    CORRADE_COMPARE(b.size(), 5);
+}
+
+void ArenaAllocatorTest::allocateValueInit() {
+    ArenaAllocator arena;
+
+    /* Dirty the memory first, reset will make it available again */
+    {
+        Array<int> a = arena.allocate<int>(NoInit, 16);
+        for(int& i: a) i = 0x5a5a;
+    }
+    arena.reset();
+
+    Array<int> a = arena.allocate<int>(ValueInit, 16);
+    CORRADE_COMPARE(a.size(), 16);
+    for(int i: a) CORRADE_COMPARE(i, 0);
+}
+
+void ArenaAllocatorTest::allocateDirectInit() {
+    ArenaAllocator arena;
+    Array<int> a = arena.allocate<int>(DirectInit, 4, -35);
+    CORRADE_COMPARE(a.size(), 4);
+    for(int i: a) CORRADE_COMPARE(i, -35);
+}
+
+void ArenaAllocatorTest::allocateZeroSize() {
+    ArenaAllocator arena;
+    Array<int> a = arena.allocate<int>(0);
+    CORRADE_VERIFY(!a.data());
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_COMPARE(arena.blockCount(), 0);
+}
+
+namespace {
+    struct alignas(64) Aligned {
+        char data[3];
+    };
+}
+
+void ArenaAllocatorTest::allocateAligned() {
+    ArenaAllocator arena;
+    Array<char> a = arena.allocate<char>(3);
+    Array<Aligned> b = arena.allocate<Aligned>(2);
+    Array<char> c = arena.allocate<char>(1);
+    Array<double> d = arena.allocate<double>(3);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(b.data()) % 64, 0);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(d.data()) % alignof(double), 0);
+    CORRADE_COMPARE(arena.blockCount(), 1);
+}
+
+void ArenaAllocatorTest::allocateLarge() {
+    ArenaAllocator arena{256};
+    Array<char> a = arena.allocate<char>(100);
+    Array<char> b = arena.allocate<char>(1000);
+    CORRADE_COMPARE(arena.blockCount(), 2);
+
+    /* The large allocation doesn't waste the rest of the current block */
+    Array<char> c = arena.allocate<char>(100);
+    CORRADE_COMPARE(arena.blockCount(), 2);
+    CORRADE_VERIFY(c.data() > a.data() && c.data() < a.data() + 256);
+
+    /* But a block that's full is not used anymore */
+    Array<char> d = arena.allocate<char>(100);
+    CORRADE_COMPARE(arena.blockCount(), 3);
+    for(char& i: b) i = 'b';
+    for(char& i: d) i = 'd';
+    CORRADE_COMPARE(b[999], 'b');
+}
+
+void ArenaAllocatorTest::reset() {
+    ArenaAllocator arena{256};
+    const int* first;
+    {
+        Array<int> a = arena.allocate<int>(20);
+        Array<int> b = arena.allocate<int>(20);
+        Array<int> c = arena.allocate<int>(20);
+        first = a.data();
+        CORRADE_COMPARE(arena.blockCount(), 2);
+    }
+
+    /* All arrays are gone, the memory is reused */
+    arena.reset();
+    CORRADE_COMPARE(arena.blockCount(), 2);
+    {
+        Array<int> a = arena.allocate<int>(20);
+        Array<int> b = arena.allocate<int>(20);
+        Array<int> c = arena.allocate<int>(20);
+        CORRADE_COMPARE(a.data(), first);
+        CORRADE_COMPARE(arena.blockCount(), 2);
+    }
+}
+
+void ArenaAllocatorTest::resetLiveArrays() {
+    ArenaAllocator arena{256};
+    Array<int> a = arena.allocate<int>(DirectInit, 20, 3);
+    arena.allocate<int>(20);
+    arena.allocate<int>(20);
+    CORRADE_COMPARE(arena.blockCount(), 2);
+
+    /* The first block has a live array, so it's detached from the arena */
+    arena.reset();
+    CORRADE_COMPARE(arena.blockCount(), 1);
+
+    /* The array is still usable and new ones don't overlap it */
+    Array<int> b = arena.allocate<int>(DirectInit, 20, 5);
+    CORRADE_VERIFY(b.data() + 20 <= a.data() || a.data() + 20 <= b.data());
+    CORRADE_COMPARE(a[19], 3);
+    CORRADE_COMPARE(b[0], 5);
+
+    /* Destroying the last array deletes the detached block */
+    a = nullptr;
+}
+
+void ArenaAllocatorTest::resetLarge() {
+    ArenaAllocator arena{256};
+    const int* first;
+    {
+        Array<int> a = arena.allocate<int>(20);
+        Array<int> b = arena.allocate<int>(20);
+        Array<int> c = arena.allocate<int>(20);
+        Array<int> d = arena.allocate<int>(20);
+        first = a.data();
+        CORRADE_COMPARE(arena.blockCount(), 2);
+    }
+
+    /* Blocks dedicated to large allocations are not kept after a reset */
+    arena.reset();
+    {
+        Array<char> large = arena.allocate<char>(1000);
+        CORRADE_COMPARE(arena.blockCount(), 3);
+    }
+    arena.reset();
+    CORRADE_COMPARE(arena.blockCount(), 2);
+
+    /* Retained blocks are reused even if a large allocation got put in
+       between */
+    {
+        Array<int> a = arena.allocate<int>(20);
+        Array<int> b = arena.allocate<int>(20);
+        Array<char> large = arena.allocate<char>(1000);
+        Array<int> c = arena.allocate<int>(20);
+        Array<int> d = arena.allocate<int>(20);
+        CORRADE_COMPARE(a.data(), first);
+        CORRADE_COMPARE(arena.blockCount(), 3);
+    }
+    arena.reset();
+    CORRADE_COMPARE(arena.blockCount(), 2);
+}
+
+void ArenaAllocatorTest::destroyLiveArrays() {
+    Array<int> a;
+    {
+        ArenaAllocator arena;
+        a = arena.allocate<int>(DirectInit, 20, 3);
+    }
+
+    /* The block is deleted together with the array */
+    CORRADE_COMPARE(a[19], 3);
+}
+
+namespace {
+    struct Counted {
+        static int constructed;
+        static int destructed;
+
+        Counted() { ++constructed; }
+        ~Counted() { ++destructed; }
+    };
+
+    int Counted::constructed = 0;
+    int Counted::destructed = 0;
+}
+
+void ArenaAllocatorTest::destructors() {
+    Counted::constructed = Counted::destructed = 0;
+
+    {
+        ArenaAllocator arena;
+        Array<Counted> a = arena.allocate<Counted>(5);
+        Array<Counted> b = arena.allocate<Counted>(ValueInit, 3);
+        CORRADE_COMPARE(Counted::constructed, 8);
+
+        b = nullptr;
+        CORRADE_COMPARE(Counted::destructed, 3);
+    }
+
+    CORRADE_COMPARE(Counted::destructed, 8);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::ArenaAllocatorTest)
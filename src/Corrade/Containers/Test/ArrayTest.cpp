@@ -37,6 +37,8 @@ struct ArrayTest: TestSuite::Tester {
     void constructValueInit();
     void constructNoInit();
     void constructDirectInit();
+    void constructAlignedInit();
+    void constructAlignedInitValueInit();
     void construct();
     void constructFromExisting();
     void constructZeroSize();
@@ -58,6 +60,8 @@ struct ArrayTest: TestSuite::Tester {
 
     void customDeleter();
     void customDeleterType();
+    void customDeleterTypeEmpty();
+    void customDeleterTypeEmptyFunctionPointer();
 };
 
 typedef Containers::Array<int> Array;
@@ -69,6 +73,8 @@ ArrayTest::ArrayTest() {
               &ArrayTest::constructValueInit,
               &ArrayTest::constructNoInit,
               &ArrayTest::constructDirectInit,
+              &ArrayTest::constructAlignedInit,
+              &ArrayTest::constructAlignedInitValueInit,
               &ArrayTest::construct,
               &ArrayTest::constructFromExisting,
               &ArrayTest::constructZeroSize,
@@ -89,7 +95,9 @@ ArrayTest::ArrayTest() {
               &ArrayTest::release,
 
               &ArrayTest::customDeleter,
-              &ArrayTest::customDeleterType});
+              &ArrayTest::customDeleterType,
+              &ArrayTest::customDeleterTypeEmpty,
+              &ArrayTest::customDeleterTypeEmptyFunctionPointer});
 }
 
 void ArrayTest::constructEmpty() {
@@ -170,6 +178,49 @@ void ArrayTest::constructDirectInit() {
     CORRADE_COMPARE(a[1], -37);
 }
 
+namespace {
+    struct Bar {
+        static int instanceCount;
+        Bar() { ++instanceCount; }
+        ~Bar() { --instanceCount; }
+    };
+
+    int Bar::instanceCount = 0;
+}
+
+void ArrayTest::constructAlignedInit() {
+    const Array a{AlignedInit<64>(), 5};
+    CORRADE_VERIFY(a);
+    CORRADE_COMPARE(a.size(), 5);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a.data()) % 64, 0);
+    CORRADE_VERIFY(a.deleter() != Containers::defaultDeleter<int>);
+
+    /* Alignment smaller than the pointer size */
+    const Containers::Array<char> b{AlignedInit<2>(), 3};
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(b.data()) % 2, 0);
+
+    /* Zero-length should not allocate */
+    const Array c{AlignedInit<32>(), 0};
+    CORRADE_VERIFY(c == nullptr);
+    CORRADE_COMPARE(c.size(), 0);
+
+    /* Destructors are called */
+    Bar::instanceCount = 0;
+    {
+        const Containers::Array<Bar> d{AlignedInit<128>(), 7};
+        CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(d.data()) % 128, 0);
+        CORRADE_COMPARE(Bar::instanceCount, 7);
+    }
+    CORRADE_COMPARE(Bar::instanceCount, 0);
+}
+
+void ArrayTest::constructAlignedInitValueInit() {
+    const Array a{AlignedInit<32>(), ValueInit, 100};
+    CORRADE_COMPARE(a.size(), 100);
+    CORRADE_COMPARE(reinterpret_cast<std::uintptr_t>(a.data()) % 32, 0);
+    for(int i: a) CORRADE_COMPARE(i, 0);
+}
+
 void ArrayTest::constructZeroSize() {
     const Array a(0);
 
@@ -405,6 +456,46 @@ void ArrayTest::customDeleterType() {
     CORRADE_COMPARE(deletedCount, 25);
 }
 
+namespace {
+    struct StatelessDeleter {
+        static int callCount;
+        void operator()(int*, std::size_t) { ++callCount; }
+    };
+
+    int StatelessDeleter::callCount = 0;
+}
+
+void ArrayTest::customDeleterTypeEmpty() {
+    StatelessDeleter::callCount = 0;
+
+    {
+        /* Custom deleter types are default-constructed for empty arrays */
+        const Containers::Array<int, StatelessDeleter> a;
+        const Containers::Array<int, StatelessDeleter> b = nullptr;
+        CORRADE_VERIFY(a == nullptr);
+        CORRADE_VERIFY(b == nullptr);
+        CORRADE_COMPARE(b.size(), 0);
+    }
+
+    CORRADE_COMPARE(StatelessDeleter::callCount, 2);
+}
+
+void ArrayTest::customDeleterTypeEmptyFunctionPointer() {
+    /* Function pointer types defaultDeleter() can be instantiated for use it
+       also for empty arrays, instead of a null function pointer */
+    typedef void(*ConstDeleter)(const int*, std::size_t);
+    {
+        const Containers::Array<int, ConstDeleter> a;
+        const Containers::Array<int, ConstDeleter> b = nullptr;
+        CORRADE_VERIFY(a.deleter() == Containers::defaultDeleter<const int>);
+        CORRADE_VERIFY(b.deleter() == Containers::defaultDeleter<const int>);
+    }
+
+    Containers::Array<int, ConstDeleter> c{Containers::ValueInit, 3};
+    CORRADE_COMPARE(c.size(), 3);
+    CORRADE_VERIFY(c.deleter() == Containers::defaultDeleter<const int>);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Corrade::Containers::Test::ArrayTest)
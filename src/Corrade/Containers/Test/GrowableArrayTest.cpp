@@ -0,0 +1,439 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+*/
+
+#include <sstream>
+
+#include "Corrade/Containers/GrowableArray.h"
+#include "Corrade/TestSuite/Tester.h"
+
+namespace Corrade { namespace Containers { namespace Test {
+
+struct GrowableArrayTest: TestSuite::Tester {
+    explicit GrowableArrayTest();
+
+    void allocatorType();
+
+    void appendEmpty();
+    void appendNonGrowable();
+    void appendGrowth();
+    void appendList();
+    void appendNonTrivial();
+    void appendNewAllocator();
+
+    void reserve();
+    void reserveNonGrowable();
+    void reserveTooLarge();
+
+    void resizeNoInit();
+    void resizeDefaultInit();
+    void resizeValueInit();
+    void resizeDirectInit();
+    void resizeShrink();
+
+    void removeSuffix();
+    void removeSuffixNonGrowable();
+    void removeSuffixInvalid();
+
+    void shrink();
+};
+
+GrowableArrayTest::GrowableArrayTest() {
+    addTests({&GrowableArrayTest::allocatorType,
+
+              &GrowableArrayTest::appendEmpty,
+              &GrowableArrayTest::appendNonGrowable,
+              &GrowableArrayTest::appendGrowth,
+              &GrowableArrayTest::appendList,
+              &GrowableArrayTest::appendNonTrivial,
+              &GrowableArrayTest::appendNewAllocator,
+
+              &GrowableArrayTest::reserve,
+              &GrowableArrayTest::reserveNonGrowable,
+              &GrowableArrayTest::reserveTooLarge,
+
+              &GrowableArrayTest::resizeNoInit,
+              &GrowableArrayTest::resizeDefaultInit,
+              &GrowableArrayTest::resizeValueInit,
+              &GrowableArrayTest::resizeDirectInit,
+              &GrowableArrayTest::resizeShrink,
+
+              &GrowableArrayTest::removeSuffix,
+              &GrowableArrayTest::removeSuffixNonGrowable,
+              &GrowableArrayTest::removeSuffixInvalid,
+
+              &GrowableArrayTest::shrink});
+}
+
+namespace {
+    /* Counts live instances to verify nothing is leaked or destroyed twice */
+    struct Movable {
+        static int constructed;
+        static int destructed;
+
+        explicit Movable(int a = 0): a{a} { ++constructed; }
+        Movable(const Movable& other): a{other.a} { ++constructed; }
+        Movable(Movable&& other): a{other.a} {
+            ++constructed;
+            other.a = -1;
+        }
+        ~Movable() { ++destructed; }
+
+        Movable& operator=(const Movable&) = default;
+
+        int a;
+    };
+
+    int Movable::constructed = 0;
+    int Movable::destructed = 0;
+}
+
+void GrowableArrayTest::allocatorType() {
+    CORRADE_VERIFY((std::is_same<ArrayAllocator<int>, ArrayMallocAllocator<int>>::value));
+    CORRADE_VERIFY((std::is_same<ArrayAllocator<Movable>, ArrayNewAllocator<Movable>>::value));
+
+    /* Data are aligned for the type */
+    CORRADE_COMPARE(ArrayMallocAllocator<char>::AllocationOffset, sizeof(std::size_t));
+    CORRADE_COMPARE(ArrayMallocAllocator<double>::AllocationOffset, alignof(double) < sizeof(std::size_t) ? sizeof(std::size_t) : alignof(double));
+}
+
+void GrowableArrayTest::appendEmpty() {
+    Array<int> a;
+    CORRADE_VERIFY(!arrayIsGrowable(a));
+    CORRADE_COMPARE(arrayCapacity(a), 0);
+
+    int& value = arrayAppend(a, 42);
+    CORRADE_VERIFY(arrayIsGrowable(a));
+    CORRADE_COMPARE(&value, a.data());
+    CORRADE_COMPARE(a.size(), 1);
+    CORRADE_COMPARE(a[0], 42);
+
+    /* First allocation is at least 16 bytes */
+    CORRADE_COMPARE(arrayCapacity(a), 4);
+}
+
+void GrowableArrayTest::appendNonGrowable() {
+    Array<int> a{Containers::ValueInit, 3};
+    a[1] = 5;
+    CORRADE_VERIFY(!arrayIsGrowable(a));
+    CORRADE_COMPARE(arrayCapacity(a), 3);
+
+    arrayAppend(a, 17);
+    CORRADE_VERIFY(arrayIsGrowable(a));
+    CORRADE_COMPARE(a.size(), 4);
+    CORRADE_COMPARE(arrayCapacity(a), 6);
+    CORRADE_COMPARE(a[0], 0);
+    CORRADE_COMPARE(a[1], 5);
+    CORRADE_COMPARE(a[2], 0);
+    CORRADE_COMPARE(a[3], 17);
+}
+
+void GrowableArrayTest::appendGrowth() {
+    Array<int> a;
+    std::size_t reallocations = 0;
+    const int* data = nullptr;
+    for(int i = 0; i != 1000; ++i) {
+        arrayAppend(a, i);
+        if(a.data() != data) {
+            data = a.data();
+            ++reallocations;
+        }
+    }
+
+    CORRADE_COMPARE(a.size(), 1000);
+    CORRADE_COMPARE(arrayCapacity(a), 1024);
+    for(int i = 0; i != 1000; ++i) if(a[i] != i) {
+        CORRADE_COMPARE(a[i], i);
+        break;
+    }
+
+    /* Geometric growth, the data might not move on every realloc() though */
+    CORRADE_VERIFY(reallocations <= 9);
+
+    /* Handing the array off and destroying it doesn't need anything special */
+    Array<int> b = std::move(a);
+    CORRADE_VERIFY(arrayIsGrowable(b));
+    CORRADE_COMPARE(b.size(), 1000);
+}
+
+void GrowableArrayTest::appendList() {
+    Array<int> a;
+    arrayAppend(a, 1);
+
+    const int values[]{2, 3, 4, 5, 6};
+    ArrayView<int> appended = arrayAppend(a, values);
+    CORRADE_COMPARE(a.size(), 6);
+    CORRADE_COMPARE(appended.data(), a.data() + 1);
+    CORRADE_COMPARE(appended.size(), 5);
+    for(int i = 0; i != 6; ++i) CORRADE_COMPARE(a[i], i + 1);
+
+    /* Appending other array */
+    Array<int> b{Containers::ValueInit, 2};
+    arrayAppend(a, b);
+    CORRADE_COMPARE(a.size(), 8);
+    CORRADE_COMPARE(a[7], 0);
+
+    /* Appending nothing keeps the array as it was */
+    arrayAppend(a, nullptr);
+    CORRADE_COMPARE(a.size(), 8);
+}
+
+void GrowableArrayTest::appendNonTrivial() {
+    Movable::constructed = Movable::destructed = 0;
+
+    {
+        Array<Movable> a{Containers::DirectInit, 2, 3};
+        CORRADE_COMPARE(Movable::constructed, 2);
+
+        Movable m{7};
+        arrayAppend(a, m);
+        arrayAppend(a, Movable{8});
+        CORRADE_VERIFY(arrayIsGrowable(a));
+        CORRADE_COMPARE(a.size(), 4);
+        CORRADE_COMPARE(a[0].a, 3);
+        CORRADE_COMPARE(a[1].a, 3);
+        CORRADE_COMPARE(a[2].a, 7);
+        CORRADE_COMPARE(a[3].a, 8);
+
+        for(int i = 0; i != 100; ++i) arrayAppend(a, Movable{i});
+        CORRADE_COMPARE(a.size(), 104);
+        CORRADE_COMPARE(a[103].a, 99);
+
+        /* Everything except the live elements and the local is destroyed */
+        CORRADE_COMPARE(Movable::constructed - Movable::destructed, 105);
+    }
+
+    CORRADE_COMPARE(Movable::constructed, Movable::destructed);
+}
+
+void GrowableArrayTest::appendNewAllocator() {
+    Array<int> a;
+    arrayAppend<int, ArrayNewAllocator<int>>(a, 3);
+    arrayAppend<int, ArrayNewAllocator<int>>(a, 4);
+    CORRADE_VERIFY((arrayIsGrowable<int, ArrayNewAllocator<int>>(a)));
+    CORRADE_VERIFY(!arrayIsGrowable(a));
+    CORRADE_COMPARE((arrayCapacity<int, ArrayNewAllocator<int>>(a)), 4);
+    CORRADE_COMPARE(a.size(), 2);
+    CORRADE_COMPARE(a[1], 4);
+
+    /* Growing with a different allocator reallocates it */
+    arrayAppend(a, 5);
+    CORRADE_VERIFY(arrayIsGrowable(a));
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a[0], 3);
+    CORRADE_COMPARE(a[2], 5);
+}
+
+void GrowableArrayTest::reserve() {
+    Array<int> a;
+    CORRADE_COMPARE(arrayReserve(a, 100), 100);
+    CORRADE_COMPARE(a.size(), 0);
+
+    /* Querying works on const arrays as well */
+    const Array<int>& ca = a;
+    CORRADE_VERIFY(arrayIsGrowable(ca));
+    CORRADE_COMPARE(arrayCapacity(ca), 100);
+
+    /* Appending up to the capacity doesn't reallocate */
+    const int* data = a.data();
+    for(int i = 0; i != 100; ++i) arrayAppend(a, i);
+    CORRADE_COMPARE(a.data(), data);
+
+    /* Reserving less does nothing */
+    CORRADE_COMPARE(arrayReserve(a, 50), 100);
+    CORRADE_COMPARE(a.data(), data);
+
+    CORRADE_COMPARE(arrayReserve(a, 200), 200);
+    CORRADE_COMPARE(a.size(), 100);
+    CORRADE_COMPARE(a[99], 99);
+}
+
+void GrowableArrayTest::reserveNonGrowable() {
+    Movable::constructed = Movable::destructed = 0;
+
+    {
+        Array<Movable> a{Containers::DirectInit, 3, 5};
+        CORRADE_COMPARE(arrayReserve(a, 2), 3);
+        CORRADE_VERIFY(!arrayIsGrowable(a));
+
+        CORRADE_COMPARE(arrayReserve(a, 10), 10);
+        CORRADE_VERIFY(arrayIsGrowable(a));
+        CORRADE_COMPARE(a.size(), 3);
+        CORRADE_COMPARE(a[2].a, 5);
+        CORRADE_COMPARE(Movable::constructed - Movable::destructed, 3);
+    }
+
+    CORRADE_COMPARE(Movable::constructed, Movable::destructed);
+}
+
+void GrowableArrayTest::reserveTooLarge() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    const std::size_t size = ~std::size_t{}/sizeof(int);
+
+    Array<int> a;
+    arrayReserve<int, ArrayNewAllocator<int>>(a, size);
+
+    Array<int> b;
+    arrayReserve<int, ArrayMallocAllocator<int>>(b, size);
+
+    Array<int> c;
+    arrayReserve<int, ArrayMallocAllocator<int>>(c, 1);
+    arrayReserve<int, ArrayMallocAllocator<int>>(c, size);
+    CORRADE_COMPARE((arrayCapacity<int, ArrayMallocAllocator<int>>(c)), 1);
+
+    CORRADE_COMPARE(out.str(),
+        "Containers::ArrayNewAllocator::allocate(): can't allocate " + std::to_string(size) + " elements\n"
+        "Containers::ArrayMallocAllocator::allocate(): can't allocate " + std::to_string(size) + " elements\n"
+        "Containers::ArrayMallocAllocator::reallocate(): can't allocate " + std::to_string(size) + " elements\n");
+}
+
+void GrowableArrayTest::resizeNoInit() {
+    Array<int> a;
+    arrayResize(a, Containers::NoInit, 5);
+    CORRADE_VERIFY(arrayIsGrowable(a));
+    CORRADE_COMPARE(a.size(), 5);
+    CORRADE_VERIFY(arrayCapacity(a) >= 5);
+}
+
+void GrowableArrayTest::resizeDefaultInit() {
+    Movable::constructed = Movable::destructed = 0;
+
+    {
+        Array<Movable> a;
+        arrayResize(a, 3);
+        CORRADE_COMPARE(a.size(), 3);
+        CORRADE_COMPARE(Movable::constructed, 3);
+
+        arrayResize(a, Containers::DefaultInit, 4);
+        CORRADE_COMPARE(a.size(), 4);
+        CORRADE_COMPARE(a[3].a, 0);
+    }
+
+    CORRADE_COMPARE(Movable::constructed, Movable::destructed);
+}
+
+void GrowableArrayTest::resizeValueInit() {
+    Array<int> a;
+    arrayAppend(a, 7);
+    arrayResize(a, Containers::ValueInit, 50);
+    CORRADE_COMPARE(a.size(), 50);
+    CORRADE_COMPARE(a[0], 7);
+    for(std::size_t i = 1; i != 50; ++i) if(a[i]) {
+        CORRADE_COMPARE(a[i], 0);
+        break;
+    }
+}
+
+void GrowableArrayTest::resizeDirectInit() {
+    Array<Movable> a;
+    arrayResize(a, Containers::DirectInit, 3, 15);
+    arrayResize(a, Containers::DirectInit, 5, -3);
+    CORRADE_COMPARE(a.size(), 5);
+    CORRADE_COMPARE(a[0].a, 15);
+    CORRADE_COMPARE(a[2].a, 15);
+    CORRADE_COMPARE(a[3].a, -3);
+    CORRADE_COMPARE(a[4].a, -3);
+}
+
+void GrowableArrayTest::resizeShrink() {
+    Array<int> a;
+    arrayResize(a, Containers::ValueInit, 10);
+    const int* data = a.data();
+    const std::size_t capacity = arrayCapacity(a);
+
+    /* Shrinking keeps the capacity */
+    arrayResize(a, 3);
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a.data(), data);
+    CORRADE_COMPARE(arrayCapacity(a), capacity);
+}
+
+void GrowableArrayTest::removeSuffix() {
+    Movable::constructed = Movable::destructed = 0;
+
+    {
+        Array<Movable> a;
+        for(int i = 0; i != 5; ++i) arrayAppend(a, Movable{i});
+        const int destructed = Movable::destructed;
+
+        arrayRemoveSuffix(a, 2);
+        CORRADE_COMPARE(a.size(), 3);
+        CORRADE_COMPARE(a[2].a, 2);
+        CORRADE_COMPARE(Movable::destructed, destructed + 2);
+
+        /* Removing nothing is fine */
+        arrayRemoveSuffix(a, 0);
+        CORRADE_COMPARE(a.size(), 3);
+    }
+
+    CORRADE_COMPARE(Movable::constructed, Movable::destructed);
+}
+
+void GrowableArrayTest::removeSuffixNonGrowable() {
+    Array<int> a{Containers::ValueInit, 4};
+    a[1] = 3;
+    arrayRemoveSuffix(a, 2);
+    CORRADE_VERIFY(arrayIsGrowable(a));
+    CORRADE_COMPARE(a.size(), 2);
+    CORRADE_COMPARE(a[1], 3);
+}
+
+void GrowableArrayTest::removeSuffixInvalid() {
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    Array<int> a{3};
+    arrayRemoveSuffix(a, 4);
+    CORRADE_COMPARE(out.str(), "Containers::arrayRemoveSuffix(): can't remove 4 elements from an array of 3\n");
+}
+
+void GrowableArrayTest::shrink() {
+    Movable::constructed = Movable::destructed = 0;
+
+    {
+        Array<Movable> a;
+        arrayReserve(a, 100);
+        arrayAppend(a, Movable{1});
+        arrayAppend(a, Movable{2});
+
+        arrayShrink(a);
+        CORRADE_VERIFY(!arrayIsGrowable(a));
+        CORRADE_COMPARE(a.size(), 2);
+        CORRADE_COMPARE(arrayCapacity(a), 2);
+        CORRADE_COMPARE(a[0].a, 1);
+        CORRADE_COMPARE(a[1].a, 2);
+
+        /* Non-growable array is left untouched */
+        const Movable* data = a.data();
+        arrayShrink(a);
+        CORRADE_COMPARE(a.data(), data);
+    }
+
+    CORRADE_COMPARE(Movable::constructed, Movable::destructed);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::GrowableArrayTest)
@@ -0,0 +1,413 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+*/
+
+#include <sstream>
+
+#include "Corrade/Containers/StridedArrayView.h"
+#include "Corrade/TestSuite/Tester.h"
+
+namespace Corrade { namespace Containers { namespace Test {
+
+struct StridedArrayViewTest: TestSuite::Tester {
+    explicit StridedArrayViewTest();
+
+    void constructEmpty();
+    void constructNullptr();
+    void construct();
+    void constructNegativeStride();
+    void constructInvalid();
+    void constructArrayView();
+    void constructStaticArrayView();
+    void constructFixedSize();
+    void constructConst();
+    void construct3D();
+
+    void emptyCheck();
+    void access();
+    void access3D();
+    void iterator();
+    void rangeBasedFor();
+    void rangeBasedFor2D();
+
+    void sliceInvalid();
+    void slice();
+    void slice3D();
+    void transposed();
+};
+
+typedef Containers::ArrayView<int> ArrayView;
+typedef Containers::StridedArrayView<int> StridedArrayView;
+typedef Containers::StridedArrayView<const int> ConstStridedArrayView;
+typedef Containers::StridedArrayView<int, 2> StridedArrayView2D;
+typedef Containers::StridedArrayView<int, 3> StridedArrayView3D;
+
+StridedArrayViewTest::StridedArrayViewTest() {
+    addTests({&StridedArrayViewTest::constructEmpty,
+              &StridedArrayViewTest::constructNullptr,
+              &StridedArrayViewTest::construct,
+              &StridedArrayViewTest::constructNegativeStride,
+              &StridedArrayViewTest::constructInvalid,
+              &StridedArrayViewTest::constructArrayView,
+              &StridedArrayViewTest::constructStaticArrayView,
+              &StridedArrayViewTest::constructFixedSize,
+              &StridedArrayViewTest::constructConst,
+              &StridedArrayViewTest::construct3D,
+
+              &StridedArrayViewTest::emptyCheck,
+              &StridedArrayViewTest::access,
+              &StridedArrayViewTest::access3D,
+              &StridedArrayViewTest::iterator,
+              &StridedArrayViewTest::rangeBasedFor,
+              &StridedArrayViewTest::rangeBasedFor2D,
+
+              &StridedArrayViewTest::sliceInvalid,
+              &StridedArrayViewTest::slice,
+              &StridedArrayViewTest::slice3D,
+              &StridedArrayViewTest::transposed});
+}
+
+namespace {
+    struct Vertex {
+        float position[3];
+        int id;
+    };
+}
+
+void StridedArrayViewTest::constructEmpty() {
+    const StridedArrayView a;
+    CORRADE_VERIFY(a.data() == nullptr);
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_COMPARE(a.stride(), 0);
+}
+
+void StridedArrayViewTest::constructNullptr() {
+    const StridedArrayView a = nullptr;
+    CORRADE_VERIFY(a.data() == nullptr);
+    CORRADE_COMPARE(a.size(), 0);
+    CORRADE_COMPARE(a.stride(), 0);
+
+    /* Implicit construction from nullptr should be allowed */
+    CORRADE_VERIFY((std::is_convertible<std::nullptr_t, StridedArrayView>::value));
+}
+
+void StridedArrayViewTest::construct() {
+    Vertex vertices[5]{};
+    for(int i = 0; i != 5; ++i) vertices[i].id = i*10;
+
+    const StridedArrayView a{vertices, &vertices[0].id, 5, sizeof(Vertex)};
+    CORRADE_VERIFY(a.data() == &vertices[0].id);
+    CORRADE_COMPARE(a.size(), 5);
+    CORRADE_COMPARE(a.stride(), sizeof(Vertex));
+    CORRADE_COMPARE(a[0], 0);
+    CORRADE_COMPARE(a[3], 30);
+
+    /* Passing the viewed data directly */
+    int data[6]{0, 1, 2, 3, 4, 5};
+    const StridedArrayView b{data, 3, 8};
+    CORRADE_VERIFY(b.data() == data);
+    CORRADE_COMPARE(b.size(), 3);
+    CORRADE_COMPARE(b.stride(), 8);
+    CORRADE_COMPARE(b[1], 2);
+    CORRADE_COMPARE(b[2], 4);
+}
+
+void StridedArrayViewTest::constructNegativeStride() {
+    int data[5]{0, 1, 2, 3, 4};
+
+    const StridedArrayView a{data, data + 4, 3, -8};
+    CORRADE_COMPARE(a.size(), 3);
+    CORRADE_COMPARE(a.stride(), -8);
+    CORRADE_COMPARE(a[0], 4);
+    CORRADE_COMPARE(a[1], 2);
+    CORRADE_COMPARE(a[2], 0);
+}
+
+void StridedArrayViewTest::constructInvalid() {
+    int data[6]{};
+
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    StridedArrayView{data, 4, 8};
+    StridedArrayView{data, data + 2, 3, 8};
+    StridedArrayView{data, data + 1, 3, -4};
+    StridedArrayView2D{data, {2, 3}, {12, 8}};
+
+    /* Empty views are not checked */
+    StridedArrayView{data, data + 6, 0, 4};
+    StridedArrayView2D{data, {0, 7}, {12, 4}};
+
+    CORRADE_COMPARE(out.str(),
+        "Containers::StridedArrayView: data size 24 is not enough for given size and stride\n"
+        "Containers::StridedArrayView: data size 24 is not enough for given size and stride\n"
+        "Containers::StridedArrayView: data size 24 is not enough for given size and stride\n"
+        "Containers::StridedArrayView: data size 24 is not enough for given size and stride\n");
+}
+
+void StridedArrayViewTest::constructArrayView() {
+    int data[5]{0, 1, 2, 3, 4};
+    ArrayView a = data;
+
+    const StridedArrayView b = a;
+    CORRADE_VERIFY(b.data() == data);
+    CORRADE_COMPARE(b.size(), 5);
+    CORRADE_COMPARE(b.stride(), 4);
+    CORRADE_COMPARE(b[3], 3);
+
+    const ConstStridedArrayView c = a;
+    CORRADE_VERIFY(c.data() == data);
+    CORRADE_COMPARE(c.size(), 5);
+
+    /* Only one-dimensional views are constructible from ArrayView and
+       derived types can't be viewed as their base */
+    CORRADE_VERIFY((std::is_convertible<ArrayView, StridedArrayView>::value));
+    CORRADE_VERIFY(!(std::is_convertible<ArrayView, StridedArrayView2D>::value));
+    CORRADE_VERIFY(!(std::is_convertible<Containers::ArrayView<const int>, StridedArrayView>::value));
+    CORRADE_VERIFY(!(std::is_convertible<Containers::ArrayView<float>, StridedArrayView>::value));
+}
+
+void StridedArrayViewTest::constructStaticArrayView() {
+    int data[5]{0, 1, 2, 3, 4};
+    StaticArrayView<5, int> a = data;
+
+    const StridedArrayView b = a;
+    CORRADE_VERIFY(b.data() == data);
+    CORRADE_COMPARE(b.size(), 5);
+    CORRADE_COMPARE(b.stride(), 4);
+    CORRADE_COMPARE(b[4], 4);
+}
+
+void StridedArrayViewTest::constructFixedSize() {
+    int data[5]{0, 1, 2, 3, 4};
+
+    const StridedArrayView a = data;
+    CORRADE_VERIFY(a.data() == data);
+    CORRADE_COMPARE(a.size(), 5);
+    CORRADE_COMPARE(a.stride(), 4);
+    CORRADE_COMPARE(a[2], 2);
+}
+
+void StridedArrayViewTest::constructConst() {
+    int data[6]{0, 1, 2, 3, 4, 5};
+    const StridedArrayView2D a{data, {2, 3}, {12, 4}};
+
+    const Containers::StridedArrayView<const int, 2> b = a;
+    CORRADE_VERIFY(b.data() == data);
+    CORRADE_VERIFY(b.size() == a.size());
+    CORRADE_VERIFY(b.stride() == a.stride());
+    CORRADE_COMPARE(b[1][2], 5);
+
+    CORRADE_VERIFY(!(std::is_convertible<Containers::StridedArrayView<const int, 2>, StridedArrayView2D>::value));
+}
+
+void StridedArrayViewTest::construct3D() {
+    int data[24];
+
+    const StridedArrayView3D a{data, {2, 3, 4}, {48, 16, 4}};
+    CORRADE_VERIFY(a.data() == data);
+    CORRADE_VERIFY(a.size() == (StridedDimensions<3, std::size_t>{2, 3, 4}));
+    CORRADE_VERIFY(a.stride() == (StridedDimensions<3, std::ptrdiff_t>{48, 16, 4}));
+    CORRADE_VERIFY(a.stride() != (StridedDimensions<3, std::ptrdiff_t>{48, 4, 16}));
+    CORRADE_COMPARE(a.size()[1], 3);
+    CORRADE_COMPARE(a.stride()[0], 48);
+}
+
+void StridedArrayViewTest::emptyCheck() {
+    CORRADE_VERIFY(StridedArrayView{}.empty());
+    CORRADE_VERIFY(StridedArrayView2D{}.empty());
+
+    int data[6];
+    CORRADE_VERIFY(!StridedArrayView{data}.empty());
+    CORRADE_VERIFY(!(StridedArrayView2D{data, {2, 3}, {12, 4}}.empty()));
+    CORRADE_VERIFY((StridedArrayView2D{data, {2, 0}, {12, 4}}.empty()));
+}
+
+void StridedArrayViewTest::access() {
+    int data[6]{0, 1, 2, 3, 4, 5};
+    const StridedArrayView2D a{data, {2, 3}, {12, 4}};
+
+    const StridedArrayView b = a[1];
+    CORRADE_VERIFY(b.data() == data + 3);
+    CORRADE_COMPARE(b.size(), 3);
+    CORRADE_COMPARE(b.stride(), 4);
+
+    a[0][1] = 42;
+    CORRADE_COMPARE(data[1], 42);
+    CORRADE_COMPARE(a[1][2], 5);
+
+    CORRADE_VERIFY((std::is_same<StridedArrayView::ElementType, int&>::value));
+    CORRADE_VERIFY((std::is_same<ConstStridedArrayView::ElementType, const int&>::value));
+    CORRADE_VERIFY((std::is_same<StridedArrayView2D::ElementType, StridedArrayView>::value));
+}
+
+void StridedArrayViewTest::access3D() {
+    int data[24];
+    for(int i = 0; i != 24; ++i) data[i] = i;
+    const StridedArrayView3D a{data, {2, 3, 4}, {48, 16, 4}};
+
+    const StridedArrayView2D b = a[1];
+    CORRADE_VERIFY(b.data() == data + 12);
+    CORRADE_VERIFY(b.size() == (StridedDimensions<2, std::size_t>{3, 4}));
+    CORRADE_VERIFY(b.stride() == (StridedDimensions<2, std::ptrdiff_t>{16, 4}));
+
+    CORRADE_COMPARE(a[1][2][3], 23);
+    CORRADE_COMPARE(a[0][1][2], 6);
+}
+
+void StridedArrayViewTest::iterator() {
+    int data[10]{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    const StridedArrayView a{data, 5, 8};
+
+    CORRADE_COMPARE(*a.begin(), 0);
+    CORRADE_COMPARE(*(a.begin() + 2), 4);
+    CORRADE_COMPARE(*(a.end() - 1), 8);
+    CORRADE_COMPARE(a.end() - a.begin(), 5);
+    CORRADE_VERIFY(a.begin() < a.end());
+    CORRADE_VERIFY(a.cbegin() == a.begin());
+    CORRADE_VERIFY(a.cend() != a.begin());
+
+    auto it = a.begin();
+    CORRADE_COMPARE(*it++, 0);
+    CORRADE_COMPARE(*it, 2);
+    CORRADE_COMPARE(*++it, 4);
+    it += 2;
+    CORRADE_COMPARE(*it, 8);
+    CORRADE_COMPARE(*--it, 6);
+    it -= 3;
+    CORRADE_VERIFY(it == a.begin());
+}
+
+void StridedArrayViewTest::rangeBasedFor() {
+    Vertex vertices[3]{};
+    const StridedArrayView a{vertices, &vertices[0].id, 3, sizeof(Vertex)};
+
+    for(int& i: a)
+        i = 3;
+
+    CORRADE_COMPARE(vertices[0].id, 3);
+    CORRADE_COMPARE(vertices[1].id, 3);
+    CORRADE_COMPARE(vertices[2].id, 3);
+    CORRADE_COMPARE(vertices[2].position[0], 0.0f);
+}
+
+void StridedArrayViewTest::rangeBasedFor2D() {
+    int data[6]{};
+    const StridedArrayView2D a{data, {2, 3}, {12, 4}};
+
+    int value = 0;
+    for(StridedArrayView row: a)
+        for(int& i: row)
+            i = ++value;
+
+    CORRADE_COMPARE(data[0], 1);
+    CORRADE_COMPARE(data[2], 3);
+    CORRADE_COMPARE(data[3], 4);
+    CORRADE_COMPARE(data[5], 6);
+}
+
+void StridedArrayViewTest::sliceInvalid() {
+    int data[6]{};
+    const StridedArrayView a{data, 3, 8};
+    const StridedArrayView2D b{data, {2, 3}, {12, 4}};
+
+    std::ostringstream out;
+    Error::setOutput(&out);
+
+    a.slice(2, 1);
+    a.slice(1, 4);
+    b.slice(0, 3);
+    b.slice({0, 2}, {2, 4});
+
+    CORRADE_COMPARE(out.str(), "Containers::StridedArrayView::slice(): slice out of range\n"
+                               "Containers::StridedArrayView::slice(): slice out of range\n"
+                               "Containers::StridedArrayView::slice(): slice out of range\n"
+                               "Containers::StridedArrayView::slice(): slice out of range\n");
+}
+
+void StridedArrayViewTest::slice() {
+    int data[10]{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    const StridedArrayView a{data, 5, 8};
+
+    const StridedArrayView b = a.slice(1, 4);
+    CORRADE_COMPARE(b.size(), 3);
+    CORRADE_COMPARE(b.stride(), 8);
+    CORRADE_COMPARE(b[0], 2);
+    CORRADE_COMPARE(b[2], 6);
+
+    const StridedArrayView c = a.prefix(2);
+    CORRADE_COMPARE(c.size(), 2);
+    CORRADE_COMPARE(c[1], 2);
+
+    const StridedArrayView d = a.suffix(3);
+    CORRADE_COMPARE(d.size(), 2);
+    CORRADE_COMPARE(d[0], 6);
+    CORRADE_COMPARE(d[1], 8);
+}
+
+void StridedArrayViewTest::slice3D() {
+    int data[24];
+    for(int i = 0; i != 24; ++i) data[i] = i;
+    const StridedArrayView3D a{data, {2, 3, 4}, {48, 16, 4}};
+
+    /* Slicing in the first dimension keeps the others */
+    const StridedArrayView3D b = a.suffix(1);
+    CORRADE_VERIFY(b.size() == (StridedDimensions<3, std::size_t>{1, 3, 4}));
+    CORRADE_COMPARE(b[0][0][0], 12);
+
+    const StridedArrayView3D c = a.slice({1, 1, 2}, {2, 3, 4});
+    CORRADE_VERIFY(c.size() == (StridedDimensions<3, std::size_t>{1, 2, 2}));
+    CORRADE_VERIFY(c.stride() == a.stride());
+    CORRADE_COMPARE(c[0][0][0], 18);
+    CORRADE_COMPARE(c[0][0][1], 19);
+    CORRADE_COMPARE(c[0][1][0], 22);
+    CORRADE_COMPARE(c[0][1][1], 23);
+}
+
+void StridedArrayViewTest::transposed() {
+    int data[6]{0, 1, 2, 3, 4, 5};
+    const StridedArrayView2D a{data, {2, 3}, {12, 4}};
+
+    const StridedArrayView2D b = a.transposed<0, 1>();
+    CORRADE_VERIFY(b.data() == data);
+    CORRADE_VERIFY(b.size() == (StridedDimensions<2, std::size_t>{3, 2}));
+    CORRADE_VERIFY(b.stride() == (StridedDimensions<2, std::ptrdiff_t>{4, 12}));
+    CORRADE_COMPARE(b[0][1], 3);
+    CORRADE_COMPARE(b[2][0], 2);
+    CORRADE_COMPARE(b[2][1], 5);
+
+    /* Columns of a row-major image are rows of the transposed one */
+    int value = 0;
+    for(StridedArrayView column: b)
+        for(int i: column) value = value*10 + i;
+    CORRADE_COMPARE(value, 31425);
+
+    /* Transposing back */
+    const StridedArrayView2D c = b.transposed<1, 0>();
+    CORRADE_VERIFY(c.size() == a.size());
+    CORRADE_VERIFY(c.stride() == a.stride());
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Corrade::Containers::Test::StridedArrayViewTest)
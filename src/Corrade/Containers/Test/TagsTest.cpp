@@ -43,6 +43,7 @@ void TagsTest::noDefaultConstructor() {
     CORRADE_VERIFY(!std::is_default_constructible<ValueInitT>::value);
     CORRADE_VERIFY(!std::is_default_constructible<NoInitT>::value);
     CORRADE_VERIFY(!std::is_default_constructible<DirectInitT>::value);
+    CORRADE_VERIFY(!std::is_default_constructible<AlignedInitT<16>>::value);
 }
 
 }}}
@@ -63,6 +63,17 @@ deprecated API included.
 #define CORRADE_BUILD_DEPRECATED
 /* (enabled by default) */
 
+/**
+@brief Build with Interconnect signal emission profiling
+
+Defined if @ref Interconnect::Emitter records per-signal emission counts, slot
+call counts and time spent in emission. Disabled by default.
+@see @ref Interconnect::Emitter::signalProfile(), @ref building-corrade,
+    @ref corrade-cmake
+*/
+#define CORRADE_BUILD_INTERCONNECT_PROFILING
+#undef CORRADE_BUILD_INTERCONNECT_PROFILING
+
 /**
 @brief Static library build
 
@@ -32,7 +32,7 @@
 
 namespace Corrade { namespace Interconnect {
 
-Connection::Connection(Connection&& other): signal(other.signal), data(other.data), connected(other.connected) {
+Connection::Connection(Connection&& other): data(other.data), connected(other.connected) {
     move(std::move(other));
 }
 
@@ -43,7 +43,6 @@ Connection::~Connection() {
 Connection& Connection::operator=(Connection&& other) {
     destroy();
 
-    signal = other.signal;
     data = other.data;
     connected = other.connected;
 
@@ -59,7 +58,7 @@ bool Connection::connect() {
     if(connected) return true;
 
     /* Create the connection */
-    Emitter::connectInternal(signal, data);
+    Emitter::connectInternal(data);
     return true;
 }
 
@@ -67,17 +66,26 @@ void Connection::disconnect() {
     /* Already disconnected or the connection doesn't exist anymore */
     if(!connected || !data) return;
 
-    Emitter::disconnectInternal(signal, data);
+    Emitter::disconnectInternal(data);
 }
 
-Connection::Connection(Implementation::SignalData signal, Implementation::AbstractConnectionData* data): signal(signal), data(data), connected(true) {
+int Connection::priority() const {
+    return data ? data->priority : 0;
+}
+
+Connection& Connection::setPriority(const int priority) {
+    if(data) Emitter::setPriorityInternal(data, priority);
+    return *this;
+}
+
+Connection::Connection(Implementation::AbstractConnectionData* data): data(data), connected(true) {
     data->connection = this;
 }
 
 void Connection::destroy() {
     /* If disconnected, delete connection data (as we are the last remaining
        owner) */
-    if(!connected) delete data;
+    if(!connected && data) Implementation::releaseConnectionData(data);
 
     /* Else remove reference to itself from connection data */
     else if(data) {
@@ -47,6 +47,8 @@ namespace Implementation {
         public:
             enum: std::size_t { Size = 2*sizeof(void*)/sizeof(std::size_t) };
 
+            explicit SignalData(): data() {}
+
             #ifndef CORRADE_MSVC2015_COMPATIBILITY
             template<class Emitter, class ...Args> SignalData(typename Emitter::Signal(Emitter::*signal)(Args...)): data() {
                 typedef typename Emitter::Signal(Emitter::*Signal)(Args...);
@@ -73,11 +75,15 @@ namespace Implementation {
                 return !operator==(other);
             }
 
-        private:
-            #ifdef CORRADE_MSVC2015_COMPATIBILITY
-            SignalData(): data() {}
-            #endif
+            /* Lexicographic ordering, used for keeping the emitter connection
+               table sorted */
+            bool operator<(const SignalData& other) const {
+                for(std::size_t i = 0; i != Size; ++i)
+                    if(data[i] != other.data[i]) return data[i] < other.data[i];
+                return false;
+            }
 
+        private:
             std::size_t data[Size];
     };
 }
@@ -157,16 +163,36 @@ class CORRADE_INTERCONNECT_EXPORT Connection {
          */
         void disconnect();
 
+        /**
+         * @brief Connection priority
+         *
+         * If connection is not possible, returns `0`.
+         * @see @ref isConnectionPossible()
+         */
+        int priority() const;
+
+        /**
+         * @brief Set connection priority
+         * @return Reference to self (for method chaining)
+         *
+         * Slots of connections with higher priority are called first, slots
+         * of connections with the same priority are called in order they
+         * were connected. Default is `0`. If connection is not possible, does
+         * nothing. See @ref Interconnect-Emitter-priorities "Emitter class documentation"
+         * for more information.
+         * @see @ref isConnectionPossible()
+         */
+        Connection& setPriority(int priority);
+
     #ifdef DOXYGEN_GENERATING_OUTPUT
     private:
     #endif
-        explicit Connection(Implementation::SignalData signal, Implementation::AbstractConnectionData* data);
+        explicit Connection(Implementation::AbstractConnectionData* data);
 
     private:
         void destroy();
         void move(Connection&& other);
 
-        Implementation::SignalData signal;
         Implementation::AbstractConnectionData* data;
         bool connected;
 };
@@ -25,6 +25,10 @@
 
 #include "Emitter.h"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
 #include "Corrade/Interconnect/Receiver.h"
 #include "Corrade/Utility/Assert.h"
 
@@ -34,24 +38,408 @@ namespace Implementation {
 
 AbstractConnectionData::~AbstractConnectionData() {}
 
+namespace {
+    bool signalLess(const SignalConnections& a, const SignalData& b) {
+        return a.signal < b;
+    }
+
+    /* GCC 4.7 doesn't support thread_local, the pool is not used there */
+    #ifndef CORRADE_GCC47_COMPATIBILITY
+    enum: std::size_t {
+        /* Alignment of blocks returned by operator new on most platforms */
+        PoolGranularity = 16,
+        PoolSizeClassCount = 8,
+        PoolChunkSize = 4096
+    };
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    /* Chunks are linked together through their first PoolGranularity bytes,
+       the rest is carved into blocks */
+    struct PoolChunk {
+        PoolChunk* next;
+    };
+
+    /* Everything below is trivially destructible and constant-initialized, so
+       it's usable also while destroying static objects, after thread_locals
+       of the main thread are gone. The spin lock is taken only when a thread
+       runs out of blocks or exits, not on the fast path. */
+    struct GlobalPool {
+        void lock() { while(spinLock.test_and_set(std::memory_order_acquire)); }
+        void unlock() { spinLock.clear(std::memory_order_release); }
+
+        std::atomic_flag spinLock = ATOMIC_FLAG_INIT;
+        /* Blocks freed by threads that exited */
+        FreeBlock* freeLists[PoolSizeClassCount]{};
+        PoolChunk* chunks{};
+        /* Blocks allocated minus blocks deallocated, summed over all exited
+           threads and everything done after a thread exited */
+        std::ptrdiff_t allocated{};
+        /* Set when static objects of the library are being destroyed */
+        bool exiting{};
+        /* Set when the chunks were freed, everything goes through operator
+           new and delete afterwards */
+        bool released{};
+    };
+
+    static_assert(std::is_trivially_destructible<GlobalPool>::value, "the global pool has to be usable while static objects get destroyed");
+
+    GlobalPool globalPool;
+
+    struct GlobalPoolLock {
+        GlobalPoolLock() { globalPool.lock(); }
+        ~GlobalPoolLock() { globalPool.unlock(); }
+    };
+
+    /* Called with the lock held. The chunks can be freed only when exiting
+       and nothing is allocated from them anymore, otherwise a static emitter
+       destroyed later would touch freed memory. */
+    void releaseGlobalPool() {
+        if(!globalPool.exiting || globalPool.allocated || globalPool.released)
+            return;
+
+        for(PoolChunk* chunk = globalPool.chunks; chunk; ) {
+            PoolChunk* const next = chunk->next;
+            ::operator delete(chunk);
+            chunk = next;
+        }
+
+        globalPool.chunks = nullptr;
+        for(FreeBlock*& freeList: globalPool.freeLists) freeList = nullptr;
+        globalPool.released = true;
+    }
+
+    enum class ThreadPoolState: std::uint8_t {
+        Unused, Active, TornDown
+    };
+
+    struct ThreadPool {
+        FreeBlock* freeLists[PoolSizeClassCount]{};
+        /* Merged into the global count when the thread exits */
+        std::ptrdiff_t allocated{};
+        ThreadPoolState state{};
+    };
+
+    static_assert(std::is_trivially_destructible<ThreadPool>::value, "the thread pool has to be usable after thread_locals get destroyed");
+
+    thread_local ThreadPool threadPool;
+
+    /* Hands the blocks of an exiting thread over to the global pool. Kept
+       separate from ThreadPool, which stays usable after this is destroyed:
+       its free lists are empty from that point on and everything goes
+       through the global pool instead. */
+    struct ThreadPoolGuard {
+        ~ThreadPoolGuard();
+
+        bool registered{};
+    };
+
+    ThreadPoolGuard::~ThreadPoolGuard() {
+        GlobalPoolLock lock;
+        for(std::size_t i = 0; i != PoolSizeClassCount; ++i) {
+            if(!threadPool.freeLists[i]) continue;
+
+            FreeBlock* last = threadPool.freeLists[i];
+            while(last->next) last = last->next;
+            last->next = globalPool.freeLists[i];
+            globalPool.freeLists[i] = threadPool.freeLists[i];
+            threadPool.freeLists[i] = nullptr;
+        }
+
+        globalPool.allocated += threadPool.allocated;
+        threadPool.allocated = 0;
+        threadPool.state = ThreadPoolState::TornDown;
+        releaseGlobalPool();
+    }
+
+    thread_local ThreadPoolGuard threadPoolGuard;
+
+    /* Frees the chunks once everything allocated from them is returned */
+    struct GlobalPoolReclaimer {
+        ~GlobalPoolReclaimer() {
+            GlobalPoolLock lock;
+            globalPool.exiting = true;
+            releaseGlobalPool();
+        }
+    } globalPoolReclaimer;
+
+    void registerThreadPool() {
+        /* Touching the guard makes it destroyed when the thread exits */
+        threadPoolGuard.registered = true;
+        threadPool.state = ThreadPoolState::Active;
+    }
+
+    /* Called with the lock held */
+    FreeBlock* takeGlobalBlocks(const std::size_t sizeClass) {
+        /* Take everything that exited threads left behind */
+        if(FreeBlock* const blocks = globalPool.freeLists[sizeClass]) {
+            globalPool.freeLists[sizeClass] = nullptr;
+            return blocks;
+        }
+
+        /* Carve a new chunk into a list of blocks */
+        const std::size_t blockSize = (sizeClass + 1)*PoolGranularity;
+        const std::size_t blockCount = (PoolChunkSize - PoolGranularity)/blockSize;
+        char* const chunk = static_cast<char*>(::operator new(PoolChunkSize));
+        reinterpret_cast<PoolChunk*>(chunk)->next = globalPool.chunks;
+        globalPool.chunks = reinterpret_cast<PoolChunk*>(chunk);
+        FreeBlock* blocks = nullptr;
+        for(std::size_t i = blockCount; i != 0; --i) {
+            FreeBlock* const block = reinterpret_cast<FreeBlock*>(chunk + PoolGranularity + (i - 1)*blockSize);
+            block->next = blocks;
+            blocks = block;
+        }
+        return blocks;
+    }
+
+    void* allocateSlow(const std::size_t sizeClass) {
+        if(threadPool.state == ThreadPoolState::Unused) registerThreadPool();
+
+        GlobalPoolLock lock;
+        if(globalPool.released)
+            return ::operator new((sizeClass + 1)*PoolGranularity);
+
+        FreeBlock* const blocks = takeGlobalBlocks(sizeClass);
+
+        /* The thread is exiting, return the rest back to the global pool */
+        if(threadPool.state == ThreadPoolState::TornDown) {
+            globalPool.freeLists[sizeClass] = blocks->next;
+            ++globalPool.allocated;
+            return blocks;
+        }
+
+        threadPool.freeLists[sizeClass] = blocks->next;
+        ++threadPool.allocated;
+        return blocks;
+    }
+
+    void deallocateSlow(void* const data, const std::size_t sizeClass) {
+        FreeBlock* const block = static_cast<FreeBlock*>(data);
+
+        if(threadPool.state == ThreadPoolState::Unused) {
+            registerThreadPool();
+            block->next = threadPool.freeLists[sizeClass];
+            threadPool.freeLists[sizeClass] = block;
+            --threadPool.allocated;
+            return;
+        }
+
+        /* The thread is exiting, give the block to the global pool */
+        GlobalPoolLock lock;
+        if(globalPool.released) {
+            ::operator delete(data);
+            return;
+        }
+
+        block->next = globalPool.freeLists[sizeClass];
+        globalPool.freeLists[sizeClass] = block;
+        --globalPool.allocated;
+        releaseGlobalPool();
+    }
+    #endif
+}
+
+void* allocateConnectionData(const std::size_t size) {
+    #ifndef CORRADE_GCC47_COMPATIBILITY
+    const std::size_t sizeClass = (size - 1)/PoolGranularity;
+    if(sizeClass < PoolSizeClassCount) {
+        /* Non-empty free list means the pool is active */
+        FreeBlock*& freeList = threadPool.freeLists[sizeClass];
+        if(!freeList) return allocateSlow(sizeClass);
+
+        FreeBlock* const block = freeList;
+        freeList = block->next;
+        ++threadPool.allocated;
+        return block;
+    }
+    #endif
+
+    return ::operator new(size);
+}
+
+void releaseConnectionData(AbstractConnectionData* const data) {
+    if(data->references.fetch_sub(1) == 1) delete data;
+}
+
+ConnectionSnapshot::~ConnectionSnapshot() {
+    for(const SignalConnections& signalConnections: connections)
+        for(AbstractConnectionData* data: signalConnections.connections)
+            releaseConnectionData(data);
+}
+
+const SignalConnections* ConnectionSnapshot::find(const SignalData& signal) const {
+    auto found = std::lower_bound(connections.begin(), connections.end(), signal, signalLess);
+    return found != connections.end() && found->signal == signal ? &*found : nullptr;
+}
+
+QueuedEvent::QueuedEvent(AbstractConnectionData* const data): data(data), next(nullptr), epoch(static_cast<AbstractMemberConnectionData*>(data)->epoch.load(std::memory_order_relaxed)) {
+    data->references.fetch_add(1, std::memory_order_relaxed);
+}
+
+QueuedEvent::~QueuedEvent() {
+    releaseConnectionData(data);
+}
+
+EventQueue::EventQueue(): head{nullptr}, closed{false}, references{1} {}
+
+void EventQueue::push(QueuedEvent* const event) {
+    event->next = head.load(std::memory_order_relaxed);
+    while(!head.compare_exchange_weak(event->next, event));
+
+    /* The receiver is gone, nobody is going to take the events anymore. If
+       the push happened after the receiver emptied the queue, the event is
+       dropped here. */
+    if(closed.load()) close();
 }
 
-Emitter::Emitter(): lastHandledSignal(0), connectionsChanged(false) {}
+QueuedEvent* EventQueue::take() {
+    QueuedEvent* event = head.exchange(nullptr);
+
+    /* Reverse the list so the oldest event is first */
+    QueuedEvent* reversed = nullptr;
+    while(event) {
+        QueuedEvent* const next = event->next;
+        event->next = reversed;
+        reversed = event;
+        event = next;
+    }
+
+    return reversed;
+}
+
+void EventQueue::close() {
+    closed.store(true);
+
+    QueuedEvent* event = take();
+    while(event) {
+        QueuedEvent* const next = event->next;
+        delete event;
+        event = next;
+    }
+}
+
+void releaseEventQueue(EventQueue* const queue) {
+    if(queue->references.fetch_sub(1) == 1) delete queue;
+}
+
+/* Emission registers itself in the reader count of the current epoch. After
+   publishing a new snapshot, the old one is retired into the current epoch
+   and the epoch is advanced if there's no reader left from the previous one.
+   Everything retired in the previous epoch is freed at that point, as no
+   reader can reference it anymore. */
+struct EmitterThreadSafety {
+    explicit EmitterThreadSafety(): current{new ConnectionSnapshot}, epoch{0} {
+        readers[0] = 0;
+        readers[1] = 0;
+    }
+
+    std::mutex mutex;
+    std::atomic<const ConnectionSnapshot*> current;
+    std::atomic<std::uint32_t> epoch;
+    std::atomic<std::size_t> readers[2];
+    std::vector<const ConnectionSnapshot*> retired[2];
+};
+
+void deallocateConnectionData(void* const data, const std::size_t size) {
+    #ifndef CORRADE_GCC47_COMPATIBILITY
+    const std::size_t sizeClass = (size - 1)/PoolGranularity;
+    if(sizeClass < PoolSizeClassCount) {
+        if(threadPool.state != ThreadPoolState::Active) {
+            deallocateSlow(data, sizeClass);
+            return;
+        }
+
+        FreeBlock*& freeList = threadPool.freeLists[sizeClass];
+        FreeBlock* const block = static_cast<FreeBlock*>(data);
+        block->next = freeList;
+        freeList = block;
+        --threadPool.allocated;
+        return;
+    }
+    #else
+    static_cast<void>(size);
+    #endif
+
+    ::operator delete(data);
+}
+
+}
+
+Emitter::Emitter(): connectionCount(0), emissionDepth(0), signalGeneration(0), slotGeneration(0), connectionObserver(nullptr) {}
+
+Emitter::Emitter(ThreadSafeT): connectionCount(0), emissionDepth(0), signalGeneration(0), slotGeneration(0), connectionObserver(nullptr), threadSafety{new Implementation::EmitterThreadSafety} {}
+
+Emitter::Emitter(Emitter&& other) noexcept: connections{std::move(other.connections)}, connectionCount{other.connectionCount}, emissionDepth{0}, signalGeneration{other.signalGeneration}, slotGeneration{0}, connectionObserver{nullptr}, signalIndices{std::move(other.signalIndices)}, deferredEmissions{std::move(other.deferredEmissions)}, forwardedConnections{std::move(other.forwardedConnections)}, threadSafety{std::move(other.threadSafety)}
+    #ifdef CORRADE_BUILD_INTERCONNECT_PROFILING
+    , profiles{std::move(other.profiles)}
+    #endif
+{
+    CORRADE_ASSERT(!other.emissionDepth,
+        "Interconnect::Emitter: can't move an emitter while emitting", );
+
+    other.connections.clear();
+    other.connectionCount = 0;
+    other.signalIndices.clear();
+    other.deferredEmissions.clear();
+    other.forwardedConnections.clear();
+    /* So anything caching signal entry positions of the moved-from instance
+       notices the change. The connection observer isn't notified, the
+       subclass is expected to move its own state as well. */
+    ++other.signalGeneration;
+
+    moveInternal();
+}
+
+Emitter& Emitter::operator=(Emitter&& other) noexcept {
+    CORRADE_ASSERT(!emissionDepth && !other.emissionDepth,
+        "Interconnect::Emitter: can't move an emitter while emitting", *this);
+
+    using std::swap;
+    swap(connections, other.connections);
+    swap(connectionCount, other.connectionCount);
+    swap(signalGeneration, other.signalGeneration);
+    swap(signalIndices, other.signalIndices);
+    swap(deferredEmissions, other.deferredEmissions);
+    swap(forwardedConnections, other.forwardedConnections);
+    swap(threadSafety, other.threadSafety);
+    #ifdef CORRADE_BUILD_INTERCONNECT_PROFILING
+    swap(profiles, other.profiles);
+    #endif
+
+    moveInternal();
+    other.moveInternal();
+    return *this;
+}
+
+void Emitter::moveInternal() {
+    /* Point the connections back to this instance. Snapshots of thread-safe
+       emitters reference the same connection data, so they don't need any
+       update. */
+    for(const Implementation::SignalConnections& signalConnections: connections)
+        for(Implementation::AbstractConnectionData* data: signalConnections.connections)
+            if(data) data->emitter = this;
+    for(Implementation::SignalConnectionData* data: forwardedConnections)
+        data->target = this;
+}
 
 Emitter::~Emitter() {
-    for(auto connection: connections) {
-        const Implementation::AbstractConnectionData* data = connection.second;
+    for(Implementation::DeferredEmission* emission: deferredEmissions)
+        delete emission;
+
+    /* No emission can be in progress at this point, free all snapshots */
+    if(threadSafety) {
+        delete threadSafety->current.load();
+        for(const std::vector<const Implementation::ConnectionSnapshot*>& retired: threadSafety->retired)
+            for(const Implementation::ConnectionSnapshot* snapshot: retired) delete snapshot;
+    }
+
+    for(const Implementation::SignalConnections& signalConnections: connections) for(Implementation::AbstractConnectionData* data: signalConnections.connections) {
+        if(!data) continue;
 
         /* Remove connection from receiver, if this is member function connection */
-        if(data->type == Implementation::AbstractConnectionData::Type::Member) {
-            auto& receiverConnections = static_cast<const Implementation::AbstractMemberConnectionData*>(data)->receiver->connections;
-            for(auto end = receiverConnections.end(), rit = receiverConnections.begin(); rit != end; ++rit) {
-                if(*rit != data) continue;
-
-                receiverConnections.erase(rit);
-                break;
-            }
-        }
+        eraseReceiverInternal(data);
 
         /* If there is connection object, remove reference to connection data
            from it and mark it as disconnected */
@@ -62,78 +450,455 @@ Emitter::~Emitter() {
         }
 
         /* Delete connection data (as they make no sense without emitter) */
-        delete data;
+        Implementation::releaseConnectionData(data);
+    }
+
+    /* Remove signal connections forwarding to this emitter from their
+       emitters, same as Receiver does with its slot connections */
+    for(Implementation::SignalConnectionData* data: forwardedConnections) {
+        eraseInternal(data);
+
+        if(data->connection) {
+            CORRADE_INTERNAL_ASSERT(data == data->connection->data);
+            data->connection->data = nullptr;
+            data->connection->connected = false;
+        }
+
+        Implementation::releaseConnectionData(data);
+    }
+}
+
+const Implementation::SignalConnections* Emitter::findSignalConnections(const Implementation::SignalData& signal) const {
+    auto found = std::lower_bound(connections.begin(), connections.end(), signal, Implementation::signalLess);
+    return found != connections.end() && found->signal == signal ? &*found : nullptr;
+}
+
+void Emitter::flush() {
+    /* Signals deferred by the slots go to the next flush */
+    std::vector<Implementation::DeferredEmission*> emissions;
+    std::swap(emissions, deferredEmissions);
+    for(Implementation::DeferredEmission* emission: emissions) {
+        emission->emit(*this);
+        delete emission;
+    }
+
+    /* Reuse the capacity for the next frame, if nothing was deferred
+       meanwhile */
+    if(deferredEmissions.empty()) {
+        emissions.clear();
+        std::swap(emissions, deferredEmissions);
     }
 }
 
+#ifdef CORRADE_BUILD_INTERCONNECT_PROFILING
+namespace {
+    bool profileLess(const std::pair<Implementation::SignalData, SignalProfile>& a, const Implementation::SignalData& b) {
+        return a.first < b;
+    }
+}
+
+Utility::Debug& operator<<(Utility::Debug& debug, const SignalProfile& value) {
+    return debug << "emits:" << value.emitCount << Utility::Debug::nospace << ", slot calls:" << value.slotCallCount << Utility::Debug::nospace << ", time:" << value.time.count() << "ns";
+}
+
+SignalProfile Emitter::signalProfile() const {
+    std::unique_lock<std::mutex> lock;
+    if(threadSafety) lock = std::unique_lock<std::mutex>{threadSafety->mutex};
+
+    SignalProfile out;
+    for(const std::pair<Implementation::SignalData, SignalProfile>& profile: profiles) {
+        out.emitCount += profile.second.emitCount;
+        out.slotCallCount += profile.second.slotCallCount;
+        out.time += profile.second.time;
+    }
+    return out;
+}
+
+SignalProfile Emitter::signalProfileInternal(const Implementation::SignalData& signal) const {
+    std::unique_lock<std::mutex> lock;
+    if(threadSafety) lock = std::unique_lock<std::mutex>{threadSafety->mutex};
+
+    auto found = std::lower_bound(profiles.begin(), profiles.end(), signal, profileLess);
+    return found != profiles.end() && found->first == signal ? found->second : SignalProfile{};
+}
+
+void Emitter::resetSignalProfiles() {
+    std::unique_lock<std::mutex> lock;
+    if(threadSafety) lock = std::unique_lock<std::mutex>{threadSafety->mutex};
+
+    profiles.clear();
+}
+
+void Emitter::profileInternal(const Implementation::SignalData& signal, const std::size_t slotCallCount, const std::chrono::nanoseconds time) {
+    std::unique_lock<std::mutex> lock;
+    if(threadSafety) lock = std::unique_lock<std::mutex>{threadSafety->mutex};
+
+    auto found = std::lower_bound(profiles.begin(), profiles.end(), signal, profileLess);
+    if(found == profiles.end() || found->first != signal)
+        found = profiles.insert(found, {signal, SignalProfile{}});
+
+    ++found->second.emitCount;
+    found->second.slotCallCount += slotCallCount;
+    found->second.time += time;
+}
+#endif
+
+Implementation::SignalConnections* Emitter::cacheSignalIndexInternal(const std::size_t index, const Implementation::SignalData& signal) {
+    if(index >= signalIndices.size()) signalIndices.resize(index + 1);
+
+    Implementation::SignalConnections* signalConnections = findSignalConnections(signal);
+    Implementation::SignalIndex& signalIndex = signalIndices[index];
+    signalIndex.signal = signal;
+    signalIndex.generation = signalGeneration + 1;
+    signalIndex.position = signalConnections ? signalConnections - connections.data() : ~std::size_t{};
+    return signalConnections;
+}
+
+void Emitter::publishInternal(std::vector<const Implementation::ConnectionSnapshot*>& garbage) {
+    /* Copy the live connections, each snapshot holds a reference to them */
+    auto snapshot = new Implementation::ConnectionSnapshot;
+    for(const Implementation::SignalConnections& signalConnections: connections) {
+        if(!signalConnections.count) continue;
+
+        snapshot->connections.emplace_back(signalConnections.signal);
+        Implementation::SignalConnections& copy = snapshot->connections.back();
+        copy.connections.reserve(signalConnections.count);
+        for(Implementation::AbstractConnectionData* data: signalConnections.connections) {
+            if(!data) continue;
+
+            data->references.fetch_add(1, std::memory_order_relaxed);
+            copy.connections.push_back(data);
+        }
+        copy.count = signalConnections.count;
+    }
+
+    Implementation::EmitterThreadSafety& ts = *threadSafety;
+    const std::uint32_t epoch = ts.epoch.load();
+    ts.retired[epoch & 1].push_back(ts.current.exchange(snapshot));
+
+    /* If no reader from the previous epoch is left, advance to next epoch and
+       free what was retired in the previous one. The reader count of the
+       previous epoch is reused for the next one. */
+    if(ts.readers[(epoch + 1) & 1].load() == 0) {
+        garbage.insert(garbage.end(), ts.retired[(epoch + 1) & 1].begin(), ts.retired[(epoch + 1) & 1].end());
+        ts.retired[(epoch + 1) & 1].clear();
+        ts.epoch.store(epoch + 1);
+    }
+}
+
+const Implementation::ConnectionSnapshot* Emitter::beginEmission(std::uint32_t& epoch) {
+    Implementation::EmitterThreadSafety& ts = *threadSafety;
+
+    /* If the epoch changed in the meantime, the reader count might be already
+       checked by the writer, so try again */
+    for(;;) {
+        epoch = ts.epoch.load();
+        ts.readers[epoch & 1].fetch_add(1);
+        if(ts.epoch.load() == epoch) return ts.current.load();
+        ts.readers[epoch & 1].fetch_sub(1);
+    }
+}
+
+void Emitter::endEmission(const std::uint32_t epoch) {
+    threadSafety->readers[epoch & 1].fetch_sub(1);
+}
+
+namespace {
+
+/* Locks the emitter for connection changes if it's thread-safe and publishes
+   a new snapshot at the end. The old snapshots are freed after unlocking, as
+   that may destroy function objects that do arbitrary things. */
+class WriteLock {
+    public:
+        explicit WriteLock(std::mutex* mutex): _mutex{mutex} {
+            if(_mutex) _mutex->lock();
+        }
+
+        ~WriteLock() {
+            if(!_mutex) return;
+
+            _mutex->unlock();
+            for(const Implementation::ConnectionSnapshot* snapshot: garbage)
+                delete snapshot;
+        }
+
+        std::vector<const Implementation::ConnectionSnapshot*> garbage;
+
+    private:
+        std::mutex* _mutex;
+};
+
+}
+
+Implementation::EventQueue* Emitter::eventQueueInternal(Receiver& receiver) {
+    if(!receiver.queue) receiver.queue = new Implementation::EventQueue;
+    return receiver.queue;
+}
+
 void Emitter::connectInternal(const Implementation::SignalData& signal, Implementation::AbstractConnectionData* data) {
-    /* Add connection to emitter */
-    data->emitter->connections.insert(std::make_pair(signal, data));
-    data->emitter->connectionsChanged = true;
+    data->signal = signal;
+    connectInternal(data);
+}
+
+void Emitter::connectInternal(Implementation::AbstractConnectionData* data) {
+    Emitter& emitter = *data->emitter;
+    WriteLock lock{emitter.threadSafety ? &emitter.threadSafety->mutex : nullptr};
+
+    /* Add connection to emitter, create the signal entry if not there yet */
+    auto found = std::lower_bound(emitter.connections.begin(), emitter.connections.end(), data->signal, Implementation::signalLess);
+    if(found == emitter.connections.end() || found->signal != data->signal) {
+        found = emitter.connections.insert(found, Implementation::SignalConnections{data->signal});
+        ++emitter.signalGeneration;
+    }
+    insertInternal(*found, data, emitter.emissionDepth);
+    ++emitter.slotGeneration;
+    ++emitter.connectionCount;
+    if(!found->count++ && emitter.connectionObserver)
+        emitter.connectionObserver(emitter, data->signal, true);
 
     /* Add connection to receiver, if this is member function connection */
-    if(data->type == Implementation::AbstractConnectionData::Type::Member)
-        static_cast<Implementation::AbstractMemberConnectionData*>(data)->receiver->connections.push_back(data);
+    if(data->type == Implementation::AbstractConnectionData::Type::Member || data->type == Implementation::AbstractConnectionData::Type::Queued) {
+        auto memberData = static_cast<Implementation::AbstractMemberConnectionData*>(data);
+        memberData->receiverIndex = memberData->receiver->connections.size();
+        memberData->receiver->connections.push_back(data);
+        memberData->epoch.fetch_add(1, std::memory_order_relaxed);
+
+    /* Or to target emitter, if this is signal connection */
+    } else if(data->type == Implementation::AbstractConnectionData::Type::Signal) {
+        auto signalData = static_cast<Implementation::SignalConnectionData*>(data);
+        signalData->targetIndex = signalData->target->forwardedConnections.size();
+        signalData->target->forwardedConnections.push_back(signalData);
+    }
 
     /* If there is connection object, mark the connection as connected */
     if(data->connection) data->connection->connected = true;
+
+    if(emitter.threadSafety) emitter.publishInternal(lock.garbage);
 }
 
-void Emitter::disconnectInternal(const Implementation::SignalData& signal, Implementation::AbstractConnectionData* data) {
-    /* Find given connection, disconnect it and erase */
-    auto range = data->emitter->connections.equal_range(signal);
-    for(auto it = range.first; it != range.second; ++it) {
-        if(it->second != data) continue;
+void Emitter::insertInternal(Implementation::SignalConnections& signalConnections, Implementation::AbstractConnectionData* data, const bool append) {
+    std::vector<Implementation::AbstractConnectionData*>& connections = signalConnections.connections;
+
+    /* Shifting the connections under an emission in progress is not possible,
+       so the connection is appended and the array is sorted later if needed */
+    if(append) {
+        for(std::size_t i = connections.size(); i; --i) {
+            if(!connections[i - 1]) continue;
+            if(connections[i - 1]->priority < data->priority)
+                signalConnections.sorted = false;
+            break;
+        }
 
-        data->emitter->disconnectInternal(it);
-        data->emitter->connections.erase(it);
-        data->emitter->connectionsChanged = true;
+        data->emitterIndex = connections.size();
+        connections.push_back(data);
         return;
     }
 
-    /* The connection must be found */
-    CORRADE_ASSERT_UNREACHABLE();
+    /* Find the position after the last connection with the same or higher
+       priority. For connections with default priority this is just the end
+       of the array. */
+    std::size_t position = connections.size();
+    while(position && (!connections[position - 1] || connections[position - 1]->priority < data->priority))
+        --position;
+
+    /* Reuse a hole if there is one, otherwise shift everything after */
+    if(position != connections.size() && !connections[position]) {
+        connections[position] = data;
+    } else {
+        connections.insert(connections.begin() + position, data);
+        for(std::size_t i = position + 1; i != connections.size(); ++i)
+            if(connections[i]) ++connections[i]->emitterIndex;
+    }
+    data->emitterIndex = position;
 }
 
-void Emitter::disconnectInternal(const Implementation::SignalData& signal) {
-    auto range = connections.equal_range(signal);
-    for(auto it = range.first; it != range.second; ++it)
-        disconnectInternal(it);
+void Emitter::setPriorityInternal(Implementation::AbstractConnectionData* data, const int priority) {
+    Emitter& emitter = *data->emitter;
+    WriteLock lock{emitter.threadSafety ? &emitter.threadSafety->mutex : nullptr};
+
+    if(data->priority == priority) return;
+    data->priority = priority;
+
+    /* Not connected, will be put to proper place when connecting */
+    if(!data->connection || !data->connection->connected) return;
 
-    connections.erase(range.first, range.second);
-    connectionsChanged = true;
+    Implementation::SignalConnections* signalConnections = emitter.findSignalConnections(data->signal);
+    CORRADE_INTERNAL_ASSERT(signalConnections && signalConnections->connections[data->emitterIndex] == data);
+    signalConnections->sorted = false;
+    if(!emitter.emissionDepth) sortInternal(*signalConnections);
+
+    if(emitter.threadSafety) emitter.publishInternal(lock.garbage);
+}
+
+bool Emitter::isForwardingCycleInternal(const Implementation::SignalConnectionData* const data, const Implementation::ForwardingChain* chain) {
+    /* The target signal is being emitted if it's the source of this or any
+       of the previously followed connections. The source of the first one is
+       the signal emitted originally. */
+    if(data->target == data->emitter && data->targetSignal == data->signal)
+        return true;
+    for(; chain; chain = chain->previous)
+        if(data->target == chain->data->emitter && data->targetSignal == chain->data->signal)
+            return true;
+    return false;
+}
+
+void Emitter::disconnectInternal(Implementation::AbstractConnectionData* data) {
+    eraseInternal(data);
+    releaseInternal(data);
+}
+
+void Emitter::disconnectInternal(const Implementation::SignalData& signal) {
+    WriteLock lock{threadSafety ? &threadSafety->mutex : nullptr};
+
+    Implementation::SignalConnections* signalConnections = findSignalConnections(signal);
+    if(!signalConnections) return;
+
+    /* Clearing instead of erasing the signal entry to keep the capacity */
+    for(Implementation::AbstractConnectionData* data: signalConnections->connections)
+        if(data) releaseInternal(data);
+    connectionCount -= signalConnections->count;
+    const bool hadConnections = signalConnections->count;
+    signalConnections->connections.clear();
+    signalConnections->count = 0;
+    ++slotGeneration;
+    signalConnections->sorted = true;
+    if(hadConnections && connectionObserver)
+        connectionObserver(*this, signal, false);
+
+    if(threadSafety) publishInternal(lock.garbage);
 }
 
 void Emitter::disconnectAllSignals() {
-    for(auto it = connections.begin(); it != connections.end(); ++it)
-        disconnectInternal(it);
+    WriteLock lock{threadSafety ? &threadSafety->mutex : nullptr};
+
+    for(Implementation::SignalConnections& signalConnections: connections) {
+        for(Implementation::AbstractConnectionData* data: signalConnections.connections)
+            if(data) releaseInternal(data);
+        signalConnections.connections.clear();
+        const bool hadConnections = signalConnections.count;
+        signalConnections.count = 0;
+        signalConnections.sorted = true;
+        if(hadConnections && connectionObserver)
+            connectionObserver(*this, signalConnections.signal, false);
+    }
 
-    connections.clear();
-    connectionsChanged = true;
+    connectionCount = 0;
+    ++slotGeneration;
+
+    if(threadSafety) publishInternal(lock.garbage);
 }
 
-void Emitter::disconnectInternal(std::unordered_multimap<Implementation::SignalData, Implementation::AbstractConnectionData*, Implementation::SignalDataHash>::const_iterator it) {
-    Implementation::AbstractConnectionData* data = it->second;
+void Emitter::eraseInternal(Implementation::AbstractConnectionData* data) {
+    Emitter& emitter = *data->emitter;
+    WriteLock lock{emitter.threadSafety ? &emitter.threadSafety->mutex : nullptr};
+
+    Implementation::SignalConnections* signalConnections = emitter.findSignalConnections(data->signal);
+    CORRADE_INTERNAL_ASSERT(signalConnections && signalConnections->connections[data->emitterIndex] == data);
+
+    /* Replace the connection with nullptr instead of shifting everything
+       after it */
+    signalConnections->connections[data->emitterIndex] = nullptr;
+    --emitter.connectionCount;
+    if(!--signalConnections->count && emitter.connectionObserver)
+        emitter.connectionObserver(emitter, data->signal, false);
+
+    /* Compacting would shift connections under an emission in progress, in
+       that case it's done after the outermost emission ends. The signal
+       doesn't need to be the one being emitted. */
+    if(!emitter.emissionDepth) compactInternal(*signalConnections);
+    else if(!signalConnections->dirty) {
+        signalConnections->dirty = true;
+        emitter.dirtySignals.push_back(data->signal);
+    }
 
-    /* Remove connection from receiver, if this is member function connection */
-    if(data->type == Implementation::AbstractConnectionData::Type::Member) {
-        auto& receiverConnections = static_cast<Implementation::AbstractMemberConnectionData*>(data)->receiver->connections;
-        for(auto end = receiverConnections.end(), rit = receiverConnections.begin(); rit != end; ++rit) {
-            if(*rit != data) continue;
+    if(emitter.threadSafety) emitter.publishInternal(lock.garbage);
+}
 
-            receiverConnections.erase(rit);
-            break;
-        }
+void Emitter::compactInternal(Implementation::SignalConnections& signalConnections) {
+    /* Remove the holes only if they take up more than half of the slot array,
+       so it's amortized constant time for every removal */
+    if(signalConnections.count >= signalConnections.connections.size() - signalConnections.count)
+        return;
+
+    std::size_t out = 0;
+    for(Implementation::AbstractConnectionData* data: signalConnections.connections) {
+        if(!data) continue;
+
+        data->emitterIndex = out;
+        signalConnections.connections[out++] = data;
     }
 
+    CORRADE_INTERNAL_ASSERT(out == signalConnections.count);
+    signalConnections.connections.resize(out);
+}
+
+void Emitter::compactDirtyInternal() {
+    /* Signal entries might have moved since they were marked, so they're
+       looked up again */
+    for(const Implementation::SignalData& signal: dirtySignals) {
+        Implementation::SignalConnections* signalConnections = findSignalConnections(signal);
+        CORRADE_INTERNAL_ASSERT(signalConnections && signalConnections->dirty);
+        signalConnections->dirty = false;
+        compactInternal(*signalConnections);
+    }
+
+    dirtySignals.clear();
+}
+
+void Emitter::sortInternal(Implementation::SignalConnections& signalConnections) {
+    std::vector<Implementation::AbstractConnectionData*>& connections = signalConnections.connections;
+
+    /* Stable sort to keep the order of connecting for equal priorities,
+       removing the holes along the way */
+    connections.erase(std::remove(connections.begin(), connections.end(), nullptr), connections.end());
+    std::stable_sort(connections.begin(), connections.end(), [](const Implementation::AbstractConnectionData* a, const Implementation::AbstractConnectionData* b) {
+        return a->priority > b->priority;
+    });
+    for(std::size_t i = 0; i != connections.size(); ++i)
+        connections[i]->emitterIndex = i;
+
+    CORRADE_INTERNAL_ASSERT(connections.size() == signalConnections.count);
+    signalConnections.sorted = true;
+}
+
+void Emitter::releaseInternal(Implementation::AbstractConnectionData* data) {
+    /* Remove connection from receiver, if this is member function connection */
+    eraseReceiverInternal(data);
+
     /* If there is no connection object, destroy also connection data (as we
        are the last remaining owner) */
-    if(!data->connection) delete data;
+    if(!data->connection) Implementation::releaseConnectionData(data);
 
     /* Else mark the connection as disconnected */
     else data->connection->connected = false;
 
-    /* (erasing the iterator is up to the caller) */
+    /* (erasing the connection from emitter is up to the caller) */
+}
+
+void Emitter::eraseReceiverInternal(Implementation::AbstractConnectionData* data) {
+    /* Move the last forwarded connection of target emitter in place of the
+       removed one */
+    if(data->type == Implementation::AbstractConnectionData::Type::Signal) {
+        auto signalData = static_cast<Implementation::SignalConnectionData*>(data);
+        auto& targetConnections = signalData->target->forwardedConnections;
+        CORRADE_INTERNAL_ASSERT(targetConnections[signalData->targetIndex] == data);
+        Implementation::SignalConnectionData* const last = targetConnections.back();
+        last->targetIndex = signalData->targetIndex;
+        targetConnections[signalData->targetIndex] = last;
+        targetConnections.pop_back();
+        return;
+    }
+
+    if(data->type != Implementation::AbstractConnectionData::Type::Member && data->type != Implementation::AbstractConnectionData::Type::Queued) return;
+
+    /* Move the last receiver connection in place of the removed one */
+    auto memberData = static_cast<Implementation::AbstractMemberConnectionData*>(data);
+    auto& receiverConnections = memberData->receiver->connections;
+    CORRADE_INTERNAL_ASSERT(receiverConnections[memberData->receiverIndex] == data);
+    Implementation::AbstractConnectionData* const last = receiverConnections.back();
+    static_cast<Implementation::AbstractMemberConnectionData*>(last)->receiverIndex = memberData->receiverIndex;
+    receiverConnections[memberData->receiverIndex] = last;
+    receiverConnections.pop_back();
 }
 
 }}
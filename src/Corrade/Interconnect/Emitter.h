@@ -29,14 +29,23 @@
  * @brief Class @ref Corrade::Interconnect::Emitter
  */
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <new>
+#include <tuple>
 #include <type_traits>
-#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Corrade/Interconnect/Connection.h"
 #include "Corrade/Utility/Assert.h"
+#include "Corrade/Utility/Debug.h"
+
+#ifdef CORRADE_BUILD_INTERCONNECT_PROFILING
+#include <chrono>
+#endif
 
 namespace Corrade { namespace Interconnect {
 
@@ -51,8 +60,139 @@ struct SignalDataHash {
     }
 };
 
+/* All connections of one signal, stored contiguously in order of decreasing
+   priority and in order of connecting for equal priorities. Removed
+   connections are replaced with nullptr in constant time and the array is
+   compacted once there are more of these than live connections. Connections
+   added or reprioritized during an emission are appended and the array is
+   sorted again before the next emission. */
+struct SignalConnections {
+    explicit SignalConnections(const SignalData& signal): signal(signal), count(0), sorted(true), dirty(false) {}
+
+    SignalData signal;
+    std::vector<AbstractConnectionData*> connections;
+    std::size_t count;
+    bool sorted;
+    /* A connection was removed during an emission, compacting the slot
+       array is postponed until the outermost emission ends */
+    bool dirty;
+};
+
+/* Position of a signal entry in the emitter connection table, cached for
+   emission of indexed signals. Valid only while no signal entry is added, so
+   it remembers the emitter signal generation at the time it was found. */
+struct SignalIndex {
+    explicit SignalIndex(): generation(0), position(0) {}
+
+    SignalData signal;
+    /* Signal generation plus one, zero if not cached yet */
+    std::uint32_t generation;
+    /* ~std::size_t{} if there is no entry for the signal */
+    std::size_t position;
+};
+
+/* Immutable copy of the connection table, used for emission in thread-safe
+   emitters. Holds a reference to all connection data in it. */
+struct CORRADE_INTERCONNECT_EXPORT ConnectionSnapshot {
+    ~ConnectionSnapshot();
+
+    const SignalConnections* find(const SignalData& signal) const;
+
+    std::vector<SignalConnections> connections;
+};
+
+struct EmitterThreadSafety;
+class EventQueue;
+class QueuedEvent;
+class DeferredEmission;
+class SignalConnectionData;
+struct ForwardingChain;
+template<class...> class DeferredEmissionData;
+#ifdef CORRADE_BUILD_INTERCONNECT_PROFILING
+class EmissionProfiler;
+#endif
+
 }
 
+/**
+@brief Thread-safe emitter tag type
+
+Used to distinguish construction of thread-safe @ref Emitter.
+@see @ref ThreadSafe
+*/
+/* Explicit constructor to avoid ambiguous calls when using {} */
+struct ThreadSafeT {
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    struct Init{};
+    constexpr explicit ThreadSafeT(Init) {}
+    #endif
+};
+
+/**
+@brief Thread-safe emitter tag
+
+Use for construction of thread-safe @ref Emitter.
+*/
+constexpr ThreadSafeT ThreadSafe{ThreadSafeT::Init{}};
+
+/**
+@brief Queued connection tag type
+
+Used to distinguish queued connections in @ref Interconnect::connect() "connect()".
+@see @ref Queued
+*/
+/* Explicit constructor to avoid ambiguous calls when using {} */
+struct QueuedT {
+    #ifndef DOXYGEN_GENERATING_OUTPUT
+    struct Init{};
+    constexpr explicit QueuedT(Init) {}
+    #endif
+};
+
+/**
+@brief Queued connection tag
+
+Use for creating queued connections with @ref Interconnect::connect() "connect()".
+*/
+constexpr QueuedT Queued{QueuedT::Init{}};
+
+#if defined(CORRADE_BUILD_INTERCONNECT_PROFILING) || defined(DOXYGEN_GENERATING_OUTPUT)
+/**
+@brief Signal emission profile
+
+Available only if Corrade is built with `BUILD_INTERCONNECT_PROFILING`
+enabled. See @ref Interconnect-Emitter-profiling "Emitter documentation" for
+more information.
+@see @ref Emitter::signalProfile()
+*/
+struct SignalProfile {
+    /** @brief Constructor */
+    constexpr explicit SignalProfile(): emitCount{}, slotCallCount{}, time{} {}
+
+    /** @brief Count of emissions */
+    std::size_t emitCount;
+
+    /**
+     * @brief Count of slot calls
+     *
+     * Queued slots are counted when the event is queued, not when it's
+     * dispatched.
+     */
+    std::size_t slotCallCount;
+
+    /**
+     * @brief Cumulative time spent in emission
+     *
+     * Includes time spent in the slots and thus also in emission of other
+     * signals from the slots.
+     */
+    std::chrono::nanoseconds time;
+};
+
+/** @debugoperator{Corrade::Interconnect::SignalProfile} */
+CORRADE_INTERCONNECT_EXPORT Utility::Debug& operator<<(Utility::Debug& debug, const SignalProfile& value);
+#endif
+
 /**
 @brief Emitter object
 
@@ -89,6 +229,54 @@ postman.paymentRequired(245);
 If the signal is not declared as public function, it cannot be connected or
 called from outside the class.
 
+@anchor Interconnect-Emitter-signal-indices
+### Indexed signals
+
+Every @ref emit() looks up the signal among all connected signals of the
+emitter. For frequently emitted signals this can be avoided by giving each
+signal of the class a small unique index as a template parameter:
+@code
+class Postman: public Interconnect::Emitter {
+    public:
+        Signal messageDelivered(const std::string& message, int price = 0) {
+            return emit<0>(&Postman::messageDelivered, message, price);
+        }
+
+        Signal paymentRequired(int amount) {
+            return emit<1>(&Postman::paymentRequired, amount);
+        }
+};
+@endcode
+
+The emitter remembers where the slots of given signal are stored and the
+lookup is done again only if a signal that wasn't connected before gets
+connected. Indexed and non-indexed signals can be mixed freely, however the
+indices are shared by the whole class hierarchy, so a subclass adding indexed
+signals has to continue after the indices used by its base.
+
+@anchor Interconnect-Emitter-deferred
+### Deferred signals
+
+Signals that change often but where only the last value matters can be
+implemented using @ref emitDeferred() instead. The emission is then only
+recorded and repeated emissions of the same signal just replace the recorded
+arguments. The slots are called once for every recorded signal in the next
+@ref flush(), for example at the end of a frame:
+@code
+class Object: public Interconnect::Emitter {
+    public:
+        Signal transformationChanged(const Matrix4& transformation) {
+            return emitDeferred(&Object::transformationChanged, transformation);
+        }
+};
+
+Object object;
+object.transformationChanged(a);
+object.transformationChanged(b); // replaces a
+
+object.flush(); // slots are called with b
+@endcode
+
 @anchor Interconnect-Emitter-connections
 ## Connecting signals to slots
 
@@ -140,11 +328,29 @@ Interconnect::connect(*b, &Derived::derivedSignal, ...); // ok
 
 There are a few slot types, each type has its particular use:
 
+### Function and function object slots
+
+Plain functions, lambdas and other function objects can be connected with
+@ref Interconnect::connect() "connect()" without any requirements on the
+receiving side. Capturing lambdas are a lightweight alternative to
+@ref Receiver subclasses when the slot needs to carry some state:
+@code
+int total = 0;
+Interconnect::connect(postman, &Postman::paymentRequired, [&total](int amount) {
+    total += amount;
+});
+@endcode
+
+Note that these connections are not removed automatically when anything
+referenced from the function object is destroyed, only when the emitter is
+destroyed or the connection is explicitly removed.
+
 ### Member function slots
 
 When connecting to member function slot with @ref Interconnect::connect() "connect()",
 @p receiver must be subclass of @ref Receiver and @p slot must be non-constant
-member function with `void` as return type.
+member function with `void` or `bool` as return type, see
+@ref Interconnect-Emitter-priorities "below" for meaning of the latter.
 
 In addition to the cases mentioned above, the connection is automatically
 removed also when receiver object is destroyed. You can also use
@@ -204,8 +410,145 @@ Interconnect::connect(&foo, &Foo::signal, &a, &std::string::clear); // error, `a
 Interconnect::connect(&foo, &Foo::signal, &b, &std::string::clear); // ok
 @endcode
 
+@anchor Interconnect-Emitter-queued
+### Queued member function slots
+
+Passing @ref Queued to @ref Interconnect::connect() "connect()" creates a
+connection that doesn't call the slot when the signal is emitted. Instead, the
+arguments are copied into a lock-free event queue of the receiver and the slot
+is called from @ref Receiver::dispatchQueued(), which is usually done by the
+thread owning the receiver:
+@code
+Downloader downloader; // thread-safe, see below
+Mailbox mailbox;
+Interconnect::connect(downloader, &Downloader::finished, mailbox, &Mailbox::addMessage, Interconnect::Queued);
+
+// in the main loop
+mailbox.dispatchQueued();
+@endcode
+
+Events of connections that were removed before dispatching are dropped, the
+same happens to all pending events when the receiver is destroyed. Together
+with a thread-safe emitter this allows signalling from worker threads into a
+main loop without any locking on either side.
+
+@anchor Interconnect-Emitter-forwarding
+### Forwarding signals to other signals
+
+A signal can be connected directly to a signal of another emitter with the
+same signature. Emitting the first signal then emits also the other one,
+without any @ref Receiver in between:
+@code
+class Button: public Interconnect::Emitter {
+    public:
+        Signal clicked(int x, int y) {
+            return emit(&Button::clicked, x, y);
+        }
+};
+
+class Toolbar: public Interconnect::Emitter {
+    public:
+        Signal clicked(int x, int y) {
+            return emit(&Toolbar::clicked, x, y);
+        }
+};
+
+Button button;
+Toolbar toolbar;
+Interconnect::connect(button, &Button::clicked, toolbar, &Toolbar::clicked);
+@endcode
+
+The connection is removed when either of the emitters is destroyed. Forwarding
+connections can form arbitrary graphs, including cycles --- a signal that is
+already being emitted by the same chain of forwarding connections is not
+emitted again, so the cycles are followed only once. Signals emitted from
+slots are not part of the chain.
+
+@anchor Interconnect-Emitter-priorities
+### Slot priorities and consuming signals
+
+Slots of one signal are called in order they were connected. This can be
+changed with @ref Connection::setPriority() --- slots of connections with
+higher priority are called first, slots with the same priority keep the order
+of connecting. The default priority is `0`. The connections are kept sorted
+at the time they are made, so the emission itself is not any slower:
+@code
+Interconnect::connect(window, &Window::keyPressed, console, &Console::keyPressed)
+    .setPriority(10);
+Interconnect::connect(window, &Window::keyPressed, scene, &Scene::keyPressed);
+@endcode
+
+A slot returning `bool` can consume the signal by returning `true`, in which
+case slots after it are not called for this emission. This works for member
+function slots, function pointers and function objects. Results of queued
+slots are ignored, as they are called only after the emission finished.
+@code
+class Console: public Interconnect::Receiver {
+    public:
+        bool keyPressed(Key key) {
+            if(!isVisible()) return false;
+            // ...
+            return true; // the scene doesn't see the key anymore
+        }
+};
+@endcode
+
+Connections made or reprioritized while the signal is being emitted are called
+in order of connecting in that emission and sorted by priority from the next
+one.
+
+@anchor Interconnect-Emitter-thread-safety
+## Thread safety
+
+By default the emitter is not thread-safe and all emission and connection
+management has to be done from a single thread at a time. Emitters constructed
+with @ref Emitter(ThreadSafeT) can emit signals from any number of threads at
+once:
+@code
+class Downloader: public Interconnect::Emitter {
+    public:
+        explicit Downloader(): Interconnect::Emitter{Interconnect::ThreadSafe} {}
+
+        Signal finished(const std::string& url) {
+            return emit(&Downloader::finished, url);
+        }
+};
+@endcode
+
+Connecting and disconnecting is serialized using a mutex and after every
+change an immutable snapshot of the connections is published. Emission only
+walks the snapshot that was current when it started and never waits for
+anything. As a consequence, connections made during an emission are not
+called by it and a slot can be called from an emission that started before it
+was disconnected. Snapshots and connection data are freed once no emission can
+reference them anymore.
+
+Receivers are not protected --- each receiver should be connected to and
+disconnected from one thread at a time and it has to outlive all emissions
+that could call its slots. Similarly, the emitter itself can't be destroyed
+while a signal is being emitted. The connection count queries such as
+@ref hasSignalConnections() reflect the state after the last connect or
+disconnect and are meant to be called from the thread that manages the
+connections.
+
+@anchor Interconnect-Emitter-profiling
+## Profiling
+
+If Corrade is built with `BUILD_INTERCONNECT_PROFILING` enabled, the emitter
+records for each signal how many times it was emitted, how many slots it called
+and the time spent in the emission. The data are available through
+@ref signalProfile() and can be printed with @ref Utility::Debug:
+@code
+Utility::Debug() << postman.signalProfile(&Postman::messageDelivered);
+// emits: 1205, slot calls: 3615, time: 93014 ns
+@endcode
+
+Signals that were emitted without any connected slots are recorded too, which
+can help finding signals that are emitted for nothing. For thread-safe emitters
+the recording is synchronized with a mutex, so it's not meant for measuring
+highly contended emission.
+
 @see @ref Receiver, @ref Connection
-@todo Allow move
 */
 class CORRADE_INTERCONNECT_EXPORT Emitter {
     friend Connection;
@@ -226,17 +569,46 @@ class CORRADE_INTERCONNECT_EXPORT Emitter {
 
         explicit Emitter();
 
+        /**
+         * @brief Construct thread-safe emitter
+         *
+         * See @ref Interconnect-Emitter-thread-safety "class documentation"
+         * for more information.
+         * @see @ref isThreadSafe()
+         */
+        explicit Emitter(ThreadSafeT);
+
         /** @brief Copying is not allowed */
         Emitter(const Emitter&) = delete;
 
-        /** @brief Moving is not allowed */
-        Emitter(Emitter&&) = delete;
+        /**
+         * @brief Move constructor
+         *
+         * All connections, pending deferred signals and the thread-safety
+         * setting are transferred to the new instance without reconnecting,
+         * @p other is left without any connections. The emitter can't be
+         * moved while a signal is being emitted, for thread-safe emitters
+         * this means also from other threads.
+         */
+        Emitter(Emitter&& other) noexcept;
 
         /** @brief Copying is not allowed */
         Emitter& operator=(const Emitter&) = delete;
 
-        /** @brief Moving is not allowed */
-        Emitter& operator=(Emitter&&) = delete;
+        /**
+         * @brief Move assignment
+         *
+         * Swaps the connections, pending deferred signals and thread-safety
+         * setting with @p other. See @ref Emitter(Emitter&&) for details.
+         */
+        Emitter& operator=(Emitter&& other) noexcept;
+
+        /**
+         * @brief Whether the emitter is thread-safe
+         *
+         * @see @ref Emitter(ThreadSafeT)
+         */
+        bool isThreadSafe() const { return !!threadSafety; }
 
         /**
          * @brief Whether the emitter is connected to any slot
@@ -245,7 +617,7 @@ class CORRADE_INTERCONNECT_EXPORT Emitter {
          *      @ref Connection::isConnected(), @ref signalConnectionCount()
          */
         bool hasSignalConnections() const {
-            return !connections.empty();
+            return connectionCount != 0;
         }
 
         /**
@@ -255,13 +627,14 @@ class CORRADE_INTERCONNECT_EXPORT Emitter {
          *      @ref Connection::isConnected(), @ref signalConnectionCount()
          */
         template<class Emitter, class ...Args> bool hasSignalConnections(Signal(Emitter::*signal)(Args...)) const {
-            return connections.count(
+            const Implementation::SignalConnections* signalConnections = findSignalConnections(
                 #ifndef CORRADE_MSVC2015_COMPATIBILITY
                 Implementation::SignalData(signal)
                 #else
                 Implementation::SignalData::create<Emitter, Args...>(signal)
                 #endif
-                ) != 0;
+                );
+            return signalConnections && signalConnections->count;
         }
 
         /**
@@ -270,7 +643,7 @@ class CORRADE_INTERCONNECT_EXPORT Emitter {
          * @see @ref Receiver::slotConnectionCount(),
          *      @ref hasSignalConnections()
          */
-        std::size_t signalConnectionCount() const { return connections.size(); }
+        std::size_t signalConnectionCount() const { return connectionCount; }
 
         /**
          * @brief Count of slots connected to given signal
@@ -279,13 +652,14 @@ class CORRADE_INTERCONNECT_EXPORT Emitter {
          *      @ref hasSignalConnections()
          */
         template<class Emitter, class ...Args> std::size_t signalConnectionCount(Signal(Emitter::*signal)(Args...)) const {
-            return connections.count(
+            const Implementation::SignalConnections* signalConnections = findSignalConnections(
                 #ifndef CORRADE_MSVC2015_COMPATIBILITY
                 Implementation::SignalData(signal)
                 #else
                 Implementation::SignalData::create<Emitter, Args...>(signal)
                 #endif
                 );
+            return signalConnections ? signalConnections->count : 0;
         }
 
         /**
@@ -322,6 +696,67 @@ class CORRADE_INTERCONNECT_EXPORT Emitter {
          */
         void disconnectAllSignals();
 
+        /**
+         * @brief Count of deferred signals
+         *
+         * Count of distinct signals emitted using @ref emitDeferred() since
+         * the last @ref flush().
+         */
+        std::size_t deferredSignalCount() const { return deferredEmissions.size(); }
+
+        /**
+         * @brief Emit deferred signals
+         *
+         * Calls the slots of all signals emitted using @ref emitDeferred()
+         * since the last flush, in order in which the signals were first
+         * deferred and with the arguments of their last emission. Signals
+         * deferred by the slots during the flush are emitted in the next one.
+         *
+         * Deferred signals are not synchronized, so in thread-safe emitters
+         * the deferring and flushing has to be done from a single thread.
+         * @see @ref deferredSignalCount()
+         */
+        void flush();
+
+        #if defined(CORRADE_BUILD_INTERCONNECT_PROFILING) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief Emission profile of all signals
+         *
+         * Sum of profiles of all signals of this emitter. Available only if
+         * Corrade is built with `BUILD_INTERCONNECT_PROFILING` enabled. See
+         * @ref Interconnect-Emitter-profiling "class documentation" for more
+         * information.
+         * @see @ref resetSignalProfiles()
+         */
+        SignalProfile signalProfile() const;
+
+        /**
+         * @brief Emission profile of given signal
+         *
+         * Available only if Corrade is built with
+         * `BUILD_INTERCONNECT_PROFILING` enabled. If the signal wasn't emitted
+         * yet, returns an empty profile.
+         * @see @ref resetSignalProfiles()
+         */
+        template<class Emitter, class ...Args> SignalProfile signalProfile(Signal(Emitter::*signal)(Args...)) const {
+            return signalProfileInternal(
+                #ifndef CORRADE_MSVC2015_COMPATIBILITY
+                Implementation::SignalData(signal)
+                #else
+                Implementation::SignalData::create<Emitter, Args...>(signal)
+                #endif
+                );
+        }
+
+        /**
+         * @brief Reset emission profiles of all signals
+         *
+         * Available only if Corrade is built with
+         * `BUILD_INTERCONNECT_PROFILING` enabled.
+         */
+        void resetSignalProfiles();
+        #endif
+
     protected:
         /* Nobody will need to have (and delete) Emitter*, thus this is faster
            than public pure virtual destructor */
@@ -337,32 +772,149 @@ class CORRADE_INTERCONNECT_EXPORT Emitter {
          */
         template<class Emitter, class ...Args> Signal emit(Signal(Emitter::*signal)(Args...), typename std::common_type<Args>::type... args);
 
+        /**
+         * @brief Emit signal with given index
+         * @param signal        Signal
+         * @param args          Arguments
+         *
+         * Same as @ref emit(Signal(Emitter::*)(Args...), typename std::common_type<Args>::type...),
+         * but the signal lookup is cached under given @p index. Memory
+         * proportional to the largest index used is allocated in the emitter,
+         * so the indices should be small. See
+         * @ref Interconnect-Emitter-signal-indices "class documentation" for
+         * more information.
+         */
+        template<std::size_t index, class Emitter, class ...Args> Signal emit(Signal(Emitter::*signal)(Args...), typename std::common_type<Args>::type... args);
+
+        /**
+         * @brief Emit signal in next flush
+         * @param signal        Signal
+         * @param args          Arguments
+         *
+         * The arguments are copied and the slots are called in the next
+         * @ref flush(). If the signal was already deferred since the last
+         * flush, only the arguments are replaced. The signal argument types
+         * thus need to be copy-constructible. See
+         * @ref Interconnect-Emitter-deferred "class documentation" for more
+         * information.
+         */
+        template<class Emitter, class ...Args> Signal emitDeferred(Signal(Emitter::*signal)(Args...), typename std::common_type<Args>::type... args);
+
     private:
+        template<std::size_t, std::size_t, class, class> friend class StateMachine;
+        template<class...> friend class Implementation::DeferredEmissionData;
+        #ifdef CORRADE_BUILD_INTERCONNECT_PROFILING
+        friend Implementation::EmissionProfiler;
+        #endif
         template<class EmitterObject, class Emitter, class Receiver, class ReceiverObject, class ...Args> friend Connection connect(EmitterObject&, Signal(Emitter::*)(Args...), ReceiverObject&, void(Receiver::*)(Args...));
+        template<class EmitterObject, class Emitter, class Receiver, class ReceiverObject, class ...Args> friend Connection connect(EmitterObject&, Signal(Emitter::*)(Args...), ReceiverObject&, bool(Receiver::*)(Args...));
         template<class EmitterObject, class Emitter, class ...Args> friend Connection connect(EmitterObject&, Signal(Emitter::*)(Args...), void(*)(Args...));
+        template<class EmitterObject, class Emitter, class Functor, class ...Args> friend Connection connect(EmitterObject&, Signal(Emitter::*)(Args...), Functor);
+        template<class EmitterObject, class Emitter, class Receiver, class ReceiverObject, class ...Args> friend Connection connect(EmitterObject&, Signal(Emitter::*)(Args...), ReceiverObject&, void(Receiver::*)(Args...), QueuedT);
+        template<class EmitterObject, class Emitter, class TargetObject, class Target, class ...Args> friend Connection connect(EmitterObject&, Signal(Emitter::*)(Args...), TargetObject&, Signal(Target::*)(Args...));
 
         static void connectInternal(const Implementation::SignalData& signal, Implementation::AbstractConnectionData* data);
-        static void disconnectInternal(const Implementation::SignalData& signal, Implementation::AbstractConnectionData* data);
+        static void connectInternal(Implementation::AbstractConnectionData* data);
+        static void disconnectInternal(Implementation::AbstractConnectionData* data);
+        static void eraseInternal(Implementation::AbstractConnectionData* data);
+        static void releaseInternal(Implementation::AbstractConnectionData* data);
+        static void eraseReceiverInternal(Implementation::AbstractConnectionData* data);
+        static void compactInternal(Implementation::SignalConnections& signalConnections);
+        void compactDirtyInternal();
+        static void insertInternal(Implementation::SignalConnections& signalConnections, Implementation::AbstractConnectionData* data, bool append);
+        static void sortInternal(Implementation::SignalConnections& signalConnections);
+        static void setPriorityInternal(Implementation::AbstractConnectionData* data, int priority);
+        static Implementation::EventQueue* eventQueueInternal(Receiver& receiver);
+        static bool isForwardingCycleInternal(const Implementation::SignalConnectionData* data, const Implementation::ForwardingChain* chain);
+        void moveInternal();
 
         void disconnectInternal(const Implementation::SignalData& signal);
-        void disconnectInternal(std::unordered_multimap<Implementation::SignalData, Implementation::AbstractConnectionData*, Implementation::SignalDataHash>::const_iterator it);
 
-        std::unordered_multimap<Implementation::SignalData, Implementation::AbstractConnectionData*, Implementation::SignalDataHash> connections;
-        std::uint32_t lastHandledSignal;
-        bool connectionsChanged;
+        template<class ...Args> static bool handleInternal(Implementation::AbstractConnectionData* data, const Implementation::ForwardingChain* chain, Args... args);
+        template<class ...Args> void emitSignalInternal(const Implementation::SignalData& signal, const Implementation::ForwardingChain* chain, Args... args);
+        template<class ...Args> void emitInternal(const Implementation::SignalData& signal, Implementation::SignalConnections* signalConnections, const Implementation::ForwardingChain* chain, Args... args);
+        template<class ...Args> void emitThreadSafeInternal(const Implementation::SignalData& signal, const Implementation::ForwardingChain* chain, Args... args);
+
+        #ifdef CORRADE_BUILD_INTERCONNECT_PROFILING
+        SignalProfile signalProfileInternal(const Implementation::SignalData& signal) const;
+        void profileInternal(const Implementation::SignalData& signal, std::size_t slotCallCount, std::chrono::nanoseconds time);
+        #endif
+
+        void publishInternal(std::vector<const Implementation::ConnectionSnapshot*>& garbage);
+        const Implementation::ConnectionSnapshot* beginEmission(std::uint32_t& epoch);
+        void endEmission(std::uint32_t epoch);
+
+        Implementation::SignalConnections* findSignalConnections(const Implementation::SignalData& signal);
+        const Implementation::SignalConnections* findSignalConnections(const Implementation::SignalData& signal) const;
+        Implementation::SignalConnections* findSignalConnections(std::size_t index, const Implementation::SignalData& signal);
+        Implementation::SignalConnections* cacheSignalIndexInternal(std::size_t index, const Implementation::SignalData& signal);
+
+        /* Sorted by signal, so lookup in emit() is a binary search over
+           contiguous memory instead of hashing into node-based buckets. Once
+           added, signal entries are kept even if they have no connections
+           anymore, so their capacity can be reused. */
+        std::vector<Implementation::SignalConnections> connections;
+        std::size_t connectionCount;
+        /* Depth of emit() calls in progress. While emitting, removed
+           connections are only replaced with nullptr and the slot arrays
+           are not compacted, so indices stay valid. */
+        std::uint32_t emissionDepth;
+        /* Signals with connections removed during an emission, compacted
+           once the emission depth drops back to zero */
+        std::vector<Implementation::SignalData> dirtySignals;
+        /* Incremented every time a signal entry is added, as that moves the
+           other entries in memory */
+        std::uint32_t signalGeneration;
+        /* Incremented every time a connection is added or a whole signal is
+           disconnected, as that can reallocate or clear the slot arrays. The
+           emission loop fetches its slot array again only if this changes. */
+        std::uint32_t slotGeneration;
+        /* Called when a signal gets its first connection or loses the last
+           one, so subclasses such as StateMachine can track which signals
+           have connections. A plain function pointer instead of a virtual
+           function, nullptr if nobody is interested. */
+        void(*connectionObserver)(Emitter&, const Implementation::SignalData&, bool);
+        /* Cached signal entry positions for emit<index>() */
+        std::vector<Implementation::SignalIndex> signalIndices;
+        /* Pending signals for flush(), in order of first emitDeferred() */
+        std::vector<Implementation::DeferredEmission*> deferredEmissions;
+        /* Signal connections of other emitters forwarding to signals of this
+           one, removed when this emitter is destroyed */
+        std::vector<Implementation::SignalConnectionData*> forwardedConnections;
+        std::unique_ptr<Implementation::EmitterThreadSafety> threadSafety;
+        #ifdef CORRADE_BUILD_INTERCONNECT_PROFILING
+        /* Sorted by signal, same as the connections */
+        std::vector<std::pair<Implementation::SignalData, SignalProfile>> profiles;
+        #endif
 };
 
 namespace Implementation {
 
+/* Allocation of connection data. Sizes up to 128 bytes are served from
+   thread-local free lists refilled in 4 kB chunks, so repeated connecting and
+   disconnecting doesn't touch the heap. Larger sizes go to operator new. */
+CORRADE_INTERCONNECT_EXPORT void* allocateConnectionData(std::size_t size);
+CORRADE_INTERCONNECT_EXPORT void deallocateConnectionData(void* data, std::size_t size);
+
+/* Drops a reference to connection data and deletes them if it was the last
+   one. Besides the owner (emitter, receiver or connection object) only
+   snapshots of thread-safe emitters hold a reference. */
+CORRADE_INTERCONNECT_EXPORT void releaseConnectionData(AbstractConnectionData* data);
+
 class CORRADE_INTERCONNECT_EXPORT AbstractConnectionData {
     template<class...> friend class FunctionConnectionData;
-    template<class, class...> friend class MemberConnectionData;
+    template<class...> friend class FunctorConnectionData;
+    template<class, class, class...> friend class MemberConnectionData;
+    template<class...> friend class QueuedEventData;
     friend Interconnect::Connection;
     friend Interconnect::Emitter;
     friend Interconnect::Receiver;
+    friend ConnectionSnapshot;
+    friend QueuedEvent;
+    friend void releaseConnectionData(AbstractConnectionData*);
 
     public:
-        enum class Type: std::uint8_t { Function, Member };
+        enum class Type: std::uint8_t { Function, Functor, Member, Queued, Signal };
 
         AbstractConnectionData(const AbstractConnectionData&) = delete;
         AbstractConnectionData(AbstractConnectionData&&) = delete;
@@ -372,58 +924,164 @@ class CORRADE_INTERCONNECT_EXPORT AbstractConnectionData {
         AbstractConnectionData& operator=(const AbstractConnectionData&) = delete;
         AbstractConnectionData& operator=(AbstractConnectionData&&) = delete;
 
+        static void* operator new(std::size_t size) {
+            return allocateConnectionData(size);
+        }
+
+        /* Called with size of the most derived type, as the destructor is
+           virtual */
+        static void operator delete(void* data, std::size_t size) {
+            deallocateConnectionData(data, size);
+        }
+
     protected:
-        explicit AbstractConnectionData(Emitter* emitter, Type type): connection(nullptr), emitter(emitter), lastHandledSignal(0), type(type) {}
+        explicit AbstractConnectionData(Emitter* emitter, Type type): connection(nullptr), emitter(emitter), emitterIndex(0), references(1), priority(0), type(type) {}
 
     private:
         Connection* connection;
         Emitter* emitter;
-        std::uint32_t lastHandledSignal;
+        /* Signal and position in its slot array, for removal in constant
+           time */
+        SignalData signal;
+        std::size_t emitterIndex;
+        std::atomic<std::uint32_t> references;
+        int priority;
         Type type;
 };
 
+/* Event with copied signal arguments waiting in a receiver queue. Holds a
+   reference to the connection data. */
+class CORRADE_INTERCONNECT_EXPORT QueuedEvent {
+    friend Interconnect::Receiver;
+    friend class EventQueue;
+
+    public:
+        explicit QueuedEvent(AbstractConnectionData* data);
+
+        QueuedEvent(const QueuedEvent&) = delete;
+        QueuedEvent& operator=(const QueuedEvent&) = delete;
+
+        virtual ~QueuedEvent();
+
+    protected:
+        AbstractConnectionData* const data;
+
+    private:
+        virtual void dispatch() = 0;
+
+        QueuedEvent* next;
+        /* Connection epoch at the time of emission, the event is dropped if
+           the connection was reestablished since */
+        std::uint32_t epoch;
+};
+
+/* Drops a reference to the event queue and deletes it if it was the last
+   one */
+CORRADE_INTERCONNECT_EXPORT void releaseEventQueue(EventQueue* queue);
+
+/* Lock-free multi-producer single-consumer queue of a receiver. Producers
+   push to the head of a singly-linked list, the consumer takes the whole list
+   at once and reverses it to get the events in order of emission. Shared by
+   the receiver and its queued connections, so emission can't push into a
+   freed queue. */
+class CORRADE_INTERCONNECT_EXPORT EventQueue {
+    friend Interconnect::Receiver;
+    friend class AbstractMemberConnectionData;
+    friend void releaseEventQueue(EventQueue*);
+
+    public:
+        explicit EventQueue();
+
+        EventQueue(const EventQueue&) = delete;
+        EventQueue& operator=(const EventQueue&) = delete;
+
+        void push(QueuedEvent* event);
+
+    private:
+        /* Returns all queued events, oldest first */
+        QueuedEvent* take();
+
+        /* Drops all queued events and everything pushed afterwards */
+        void close();
+
+        std::atomic<QueuedEvent*> head;
+        std::atomic<bool> closed;
+        std::atomic<std::uint32_t> references;
+};
+
 class AbstractMemberConnectionData: public AbstractConnectionData {
     friend Interconnect::Emitter;
+    friend Interconnect::Receiver;
+    template<class, class, class...> friend class MemberConnectionData;
+    friend QueuedEvent;
 
     public:
-        template<class Emitter, class Receiver> explicit AbstractMemberConnectionData(Emitter* emitter, Receiver* receiver): AbstractConnectionData(emitter, Type::Member), receiver(receiver) {}
+        template<class Emitter, class Receiver> explicit AbstractMemberConnectionData(Emitter* emitter, Receiver* receiver, EventQueue* queue): AbstractConnectionData(emitter, queue ? Type::Queued : Type::Member), receiver(receiver), receiverIndex(0), queue(queue), epoch(0) {
+            if(queue) ++queue->references;
+        }
+
+        ~AbstractMemberConnectionData() {
+            if(queue) releaseEventQueue(queue);
+        }
 
     private:
         Receiver* receiver;
+        /* Position in receiver connection list, for removal in constant
+           time */
+        std::size_t receiverIndex;
+        /* Receiver event queue for queued connections, nullptr otherwise */
+        EventQueue* queue;
+        /* Incremented every time the connection is established, so events
+           queued before a disconnect are not dispatched after reconnecting */
+        std::atomic<std::uint32_t> epoch;
 };
 
 template<class ...Args> class BaseMemberConnectionData: public AbstractMemberConnectionData {
     friend Interconnect::Emitter;
+    template<class...> friend class QueuedEventData;
 
     public:
-        template<class Emitter, class Receiver> explicit BaseMemberConnectionData(Emitter* emitter, Receiver* receiver): AbstractMemberConnectionData(emitter, receiver) {}
+        template<class Emitter, class Receiver> explicit BaseMemberConnectionData(Emitter* emitter, Receiver* receiver, EventQueue* queue): AbstractMemberConnectionData(emitter, receiver, queue) {}
 
     private:
-        virtual void handle(Args... args) = 0;
+        /* Returns true if the slot consumed the signal */
+        virtual bool handle(Args... args) = 0;
 };
 
 #if defined(__GNUC__) && !defined(__clang__)
 /* GCC complains that this function is used but never defined. Clang is sane.
    MSVC too. WHAT THE FUCK, GCC? */
-template<class ...Args> void BaseMemberConnectionData<Args...>::handle(Args...) {
+template<class ...Args> bool BaseMemberConnectionData<Args...>::handle(Args...) {
     CORRADE_ASSERT_UNREACHABLE();
 }
 #endif
 
-template<class Receiver, class ...Args> class MemberConnectionData: public BaseMemberConnectionData<Args...> {
+/* Result is either void or bool, in the latter case the slot can consume the
+   signal */
+template<class Receiver, class Result, class ...Args> class MemberConnectionData: public BaseMemberConnectionData<Args...> {
     friend Interconnect::Emitter;
 
     public:
-        typedef void(Receiver::*Slot)(Args...);
+        typedef Result(Receiver::*Slot)(Args...);
 
-        template<class Emitter> explicit MemberConnectionData(Emitter* emitter, Receiver* receiver, void(Receiver::*slot)(Args...)): BaseMemberConnectionData<Args...>(emitter, receiver), receiver(receiver), slot(slot) {}
+        template<class Emitter> explicit MemberConnectionData(Emitter* emitter, Receiver* receiver, Slot slot, EventQueue* queue = nullptr): BaseMemberConnectionData<Args...>(emitter, receiver, queue), slot(slot) {}
 
     private:
-        void handle(Args... args) override final {
-            (receiver->*slot)(args...);
+        bool handle(Args... args) override final {
+            return call(std::is_same<Result, bool>{}, args...);
+        }
+
+        /* The receiver pointer is stored only in the base, so moving the
+           receiver has just one place to update */
+        bool call(std::true_type, Args... args) {
+            return (static_cast<Receiver*>(this->AbstractMemberConnectionData::receiver)->*slot)(args...);
+        }
+
+        bool call(std::false_type, Args... args) {
+            (static_cast<Receiver*>(this->AbstractMemberConnectionData::receiver)->*slot)(args...);
+            return false;
         }
 
-        Receiver* receiver;
         const Slot slot;
 };
 
@@ -436,11 +1094,179 @@ template<class ...Args> class FunctionConnectionData: public AbstractConnectionD
         template<class Emitter> explicit FunctionConnectionData(Emitter* emitter, Slot slot): AbstractConnectionData(emitter, Type::Function), slot(slot) {}
 
     private:
-        void handle(Args... args) { slot(args...); }
+        bool handle(Args... args) {
+            slot(args...);
+            return false;
+        }
 
         const Slot slot;
 };
 
+/* Function objects up to InlineSize are stored directly in the connection
+   data, larger ones on the heap. Calls go through a plain function pointer
+   instead of a virtual function. */
+template<class ...Args> class FunctorConnectionData: public AbstractConnectionData {
+    friend Interconnect::Emitter;
+
+    public:
+        enum: std::size_t { InlineSize = 4*sizeof(void*) };
+
+        template<class Emitter, class Functor> explicit FunctorConnectionData(Emitter* emitter, Functor&& functor): FunctorConnectionData{emitter, std::forward<Functor>(functor), std::integral_constant<bool, IsInline<typename std::decay<Functor>::type>::value>{}} {}
+
+        ~FunctorConnectionData() { destroy(storage); }
+
+        /* Whether given functor is stored directly in the connection data */
+        template<class Functor> struct IsInline: std::integral_constant<bool, sizeof(Functor) <= InlineSize && alignof(Functor) <= alignof(typename std::aligned_storage<InlineSize>::type)> {};
+
+        /* Whether given functor returns bool and can thus consume the
+           signal. Results of other types are ignored. */
+        template<class Functor> struct IsConsuming: std::is_same<decltype(std::declval<Functor&>()(std::declval<Args&>()...)), bool> {};
+
+    private:
+        typedef typename std::aligned_storage<InlineSize>::type Storage;
+
+        template<class Emitter, class Functor> explicit FunctorConnectionData(Emitter* emitter, Functor&& functor, std::true_type): AbstractConnectionData(emitter, Type::Functor), call(callInline<typename std::decay<Functor>::type>), destroy(destroyInline<typename std::decay<Functor>::type>) {
+            new(&storage) typename std::decay<Functor>::type(std::forward<Functor>(functor));
+        }
+
+        template<class Emitter, class Functor> explicit FunctorConnectionData(Emitter* emitter, Functor&& functor, std::false_type): AbstractConnectionData(emitter, Type::Functor), call(callHeap<typename std::decay<Functor>::type>), destroy(destroyHeap<typename std::decay<Functor>::type>) {
+            *reinterpret_cast<void**>(&storage) = new typename std::decay<Functor>::type(std::forward<Functor>(functor));
+        }
+
+        template<class Functor> static bool callInline(Storage& storage, Args... args) {
+            return callFunctor(*reinterpret_cast<Functor*>(&storage), IsConsuming<Functor>{}, args...);
+        }
+
+        template<class Functor> static bool callHeap(Storage& storage, Args... args) {
+            return callFunctor(**reinterpret_cast<Functor**>(&storage), IsConsuming<Functor>{}, args...);
+        }
+
+        template<class Functor> static bool callFunctor(Functor& functor, std::true_type, Args... args) {
+            return functor(args...);
+        }
+
+        template<class Functor> static bool callFunctor(Functor& functor, std::false_type, Args... args) {
+            functor(args...);
+            return false;
+        }
+
+        template<class Functor> static void destroyInline(Storage& storage) {
+            reinterpret_cast<Functor*>(&storage)->~Functor();
+        }
+
+        template<class Functor> static void destroyHeap(Storage& storage) {
+            delete *reinterpret_cast<Functor**>(&storage);
+        }
+
+        bool handle(Args... args) { return call(storage, args...); }
+
+        Storage storage;
+        bool(*const call)(Storage&, Args...);
+        void(*const destroy)(Storage&);
+};
+
+/* Forwards the emission directly to a signal of another emitter, which keeps
+   a list of these so they can be removed when it's destroyed */
+class SignalConnectionData: public AbstractConnectionData {
+    friend Interconnect::Emitter;
+
+    public:
+        explicit SignalConnectionData(Interconnect::Emitter* emitter, Interconnect::Emitter* target, const SignalData& targetSignal): AbstractConnectionData(emitter, Type::Signal), target(target), targetSignal(targetSignal), targetIndex(0) {}
+
+    private:
+        Interconnect::Emitter* target;
+        SignalData targetSignal;
+        /* Position in target forwarded connection list, for removal in
+           constant time */
+        std::size_t targetIndex;
+};
+
+/* Signal connections followed by the current emission, allocated on the
+   stack of each forwarded emission. Used to detect forwarding cycles without
+   any global or thread-local state. */
+struct ForwardingChain {
+    const SignalConnectionData* data;
+    const ForwardingChain* previous;
+};
+
+template<class ...Args> class QueuedEventData: public QueuedEvent {
+    public:
+        template<class ...T> explicit QueuedEventData(AbstractConnectionData* data, T&&... args): QueuedEvent{data}, arguments{std::forward<T>(args)...} {}
+
+    private:
+        void dispatch() override {
+            dispatchInternal(typename Utility::Implementation::GenerateSequence<sizeof...(Args)>::Type{});
+        }
+
+        template<std::size_t ...sequence> void dispatchInternal(Utility::Implementation::Sequence<sequence...>) {
+            static_cast<BaseMemberConnectionData<Args...>*>(data)->handle(std::get<sequence>(arguments)...);
+        }
+
+        std::tuple<typename std::decay<Args>::type...> arguments;
+};
+
+#ifdef CORRADE_BUILD_INTERCONNECT_PROFILING
+/* Measures one emission and records it to the emitter on destruction, so
+   all return paths of the emission are covered */
+class EmissionProfiler {
+    public:
+        explicit EmissionProfiler(Emitter& emitter, const SignalData& signal): slotCallCount{}, _emitter(emitter), _signal(signal), _begin{std::chrono::steady_clock::now()} {}
+
+        ~EmissionProfiler() {
+            _emitter.profileInternal(_signal, slotCallCount, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _begin));
+        }
+
+        std::size_t slotCallCount;
+
+    private:
+        Emitter& _emitter;
+        const SignalData& _signal;
+        std::chrono::steady_clock::time_point _begin;
+};
+#endif
+
+/* Signal emission recorded by Emitter::emitDeferred() */
+class DeferredEmission {
+    public:
+        explicit DeferredEmission(const SignalData& signal): signal(signal) {}
+
+        DeferredEmission(const DeferredEmission&) = delete;
+        DeferredEmission& operator=(const DeferredEmission&) = delete;
+
+        virtual ~DeferredEmission() = default;
+
+        virtual void emit(Emitter& emitter) = 0;
+
+        const SignalData signal;
+};
+
+template<class ...Args> class DeferredEmissionData: public DeferredEmission {
+    friend Interconnect::Emitter;
+
+    public:
+        template<class ...T> explicit DeferredEmissionData(const SignalData& signal, T&&... args): DeferredEmission{signal}, arguments{std::forward<T>(args)...} {}
+
+    private:
+        void emit(Emitter& emitter) override {
+            emitInternal(emitter, typename Utility::Implementation::GenerateSequence<sizeof...(Args)>::Type{});
+        }
+
+        template<std::size_t ...sequence> void emitInternal(Emitter& emitter, Utility::Implementation::Sequence<sequence...>) {
+            emitter.emitSignalInternal<Args...>(signal, nullptr, std::get<sequence>(arguments)...);
+        }
+
+        std::tuple<typename std::decay<Args>::type...> arguments;
+};
+
+/* Non-capturing lambdas are converted to function pointers */
+template<class ...Args, class Functor> inline AbstractConnectionData* createFunctorConnectionData(Emitter* emitter, Functor&& slot, std::true_type) {
+    return new FunctionConnectionData<Args...>(emitter, static_cast<void(*)(Args...)>(slot));
+}
+
+template<class ...Args, class Functor> inline AbstractConnectionData* createFunctorConnectionData(Emitter* emitter, Functor&& slot, std::false_type) {
+    return new FunctorConnectionData<Args...>(emitter, std::forward<Functor>(slot));
+}
+
 }
 
 /**
@@ -451,8 +1277,8 @@ template<class ...Args> class FunctionConnectionData: public AbstractConnectionD
 
 Connects given signal to compatible slot. @p emitter must be subclass of
 @ref Emitter, @p signal must be implemented signal and @p slot must be
-non-member function or non-capturing lambda with `void` as return type. The
-argument count and types must be exactly the same.
+non-member function with `void` as return type. The argument count and types
+must be exactly the same.
 
 See @ref Interconnect-Emitter-connections "Emitter class documentation" for
 more information about connections.
@@ -473,14 +1299,46 @@ template<class EmitterObject, class Emitter, class ...Args> Connection connect(E
     #endif
     auto data = new Implementation::FunctionConnectionData<Args...>(&emitter, slot);
     Interconnect::Emitter::connectInternal(signalData, data);
-    return Connection(signalData, data);
+    return Connection(data);
 }
 
-/** @overload
-@todo Why conversion of lambdas to function pointers is not done implicitly?
+/**
+@brief Connect signal to function object slot
+@param emitter       Emitter
+@param signal        Signal
+@param slot          Slot
+
+Connects given signal to lambda or any other function object callable with
+the signal arguments. Non-capturing lambdas are converted to function pointers
+and connected the same way as in
+@ref connect(EmitterObject&, Interconnect::Emitter::Signal(Emitter::*)(Args...), void(*)(Args...)).
+Other function objects are stored in the connection data --- if they are not
+larger than four pointers, without any additional allocation, larger ones are
+allocated on the heap. The object is destroyed together with the connection.
+If the function object returns `bool`, it can consume the signal by returning
+`true`, see @ref Interconnect-Emitter-priorities "Emitter class documentation"
+for details. This applies also to function pointers returning `bool`.
+
+See @ref Interconnect-Emitter-connections "Emitter class documentation" for
+more information about connections.
+
+@see @ref Emitter::hasSignalConnections(), @ref Connection::isConnected(),
+     @ref Emitter::signalConnectionCount()
 */
-template<class EmitterObject, class Emitter, class Lambda, class ...Args> Connection connect(EmitterObject& emitter, Interconnect::Emitter::Signal(Emitter::*signal)(Args...), Lambda slot) {
-    return connect(emitter, signal, static_cast<void(*)(Args...)>(slot));
+template<class EmitterObject, class Emitter, class Functor, class ...Args> Connection connect(EmitterObject& emitter, Interconnect::Emitter::Signal(Emitter::*signal)(Args...), Functor slot) {
+    static_assert(sizeof(Interconnect::Emitter::Signal(Emitter::*)(Args...)) <= 2*sizeof(void*),
+        "Size of member function pointer is incorrectly assumed to be smaller than 2*sizeof(void*)");
+    static_assert(std::is_base_of<Emitter, EmitterObject>::value,
+        "Emitter object doesn't have given signal");
+
+    #ifndef CORRADE_MSVC2015_COMPATIBILITY
+    Implementation::SignalData signalData(signal);
+    #else
+    auto signalData = Implementation::SignalData::create<EmitterObject, Args...>(signal);
+    #endif
+    auto data = Implementation::createFunctorConnectionData<Args...>(&emitter, std::move(slot), std::is_convertible<Functor, void(*)(Args...)>{});
+    Interconnect::Emitter::connectInternal(signalData, data);
+    return Connection(data);
 }
 
 /**
@@ -501,7 +1359,6 @@ more information about connections.
 
 @see @ref Emitter::hasSignalConnections(), @ref Connection::isConnected(),
      @ref Emitter::signalConnectionCount()
-@todo Connecting to signals
 */
 template<class EmitterObject, class Emitter, class Receiver, class ReceiverObject, class ...Args> Connection connect(EmitterObject& emitter, Interconnect::Emitter::Signal(Emitter::*signal)(Args...), ReceiverObject& receiver, void(Receiver::*slot)(Args...)) {
     static_assert(sizeof(Interconnect::Emitter::Signal(Emitter::*)(Args...)) <= 2*sizeof(void*),
@@ -516,57 +1373,301 @@ template<class EmitterObject, class Emitter, class Receiver, class ReceiverObjec
     #else
     auto signalData = Implementation::SignalData::create<EmitterObject, Args...>(signal);
     #endif
-    auto data = new Implementation::MemberConnectionData<ReceiverObject, Args...>(&emitter, &receiver, slot);
+    auto data = new Implementation::MemberConnectionData<ReceiverObject, void, Args...>(&emitter, &receiver, slot);
     Interconnect::Emitter::connectInternal(signalData, data);
-    return Connection(signalData, data);
+    return Connection(data);
+}
+
+/**
+@brief Connect signal to consuming member function slot
+@param emitter       Emitter
+@param signal        Signal
+@param receiver      Receiver
+@param slot          Slot
+
+Same as @ref connect(EmitterObject&, Interconnect::Emitter::Signal(Emitter::*)(Args...), ReceiverObject&, void(Receiver::*)(Args...)),
+but if the slot returns `true`, the signal is consumed and slots after it are
+not called for given emission.
+
+See @ref Interconnect-Emitter-priorities "Emitter class documentation" for
+more information about slot order.
+
+@see @ref Connection::setPriority()
+*/
+template<class EmitterObject, class Emitter, class Receiver, class ReceiverObject, class ...Args> Connection connect(EmitterObject& emitter, Interconnect::Emitter::Signal(Emitter::*signal)(Args...), ReceiverObject& receiver, bool(Receiver::*slot)(Args...)) {
+    static_assert(sizeof(Interconnect::Emitter::Signal(Emitter::*)(Args...)) <= 2*sizeof(void*),
+        "Size of member function pointer is incorrectly assumed to be smaller than 2*sizeof(void*)");
+    static_assert(std::is_base_of<Emitter, EmitterObject>::value,
+        "Emitter object doesn't have given signal");
+    static_assert(std::is_base_of<Receiver, ReceiverObject>::value,
+        "Receiver object doesn't have given slot");
+
+    #ifndef CORRADE_MSVC2015_COMPATIBILITY
+    Implementation::SignalData signalData(signal);
+    #else
+    auto signalData = Implementation::SignalData::create<EmitterObject, Args...>(signal);
+    #endif
+    auto data = new Implementation::MemberConnectionData<ReceiverObject, bool, Args...>(&emitter, &receiver, slot);
+    Interconnect::Emitter::connectInternal(signalData, data);
+    return Connection(data);
+}
+
+/**
+@brief Connect signal to member function slot using a queue
+@param emitter       Emitter
+@param signal        Signal
+@param receiver      Receiver
+@param slot          Slot
+
+Same as @ref connect(EmitterObject&, Interconnect::Emitter::Signal(Emitter::*)(Args...), ReceiverObject&, void(Receiver::*)(Args...)),
+but emitting the signal only copies the arguments into the receiver event
+queue and the slot is called later from @ref Receiver::dispatchQueued(). The
+signal argument types thus need to be copy-constructible.
+
+See @ref Interconnect-Emitter-queued "Emitter class documentation" for more
+information about queued connections.
+
+@see @ref Emitter::hasSignalConnections(), @ref Connection::isConnected(),
+     @ref Emitter::signalConnectionCount()
+*/
+template<class EmitterObject, class Emitter, class Receiver, class ReceiverObject, class ...Args> Connection connect(EmitterObject& emitter, Interconnect::Emitter::Signal(Emitter::*signal)(Args...), ReceiverObject& receiver, void(Receiver::*slot)(Args...), QueuedT) {
+    static_assert(sizeof(Interconnect::Emitter::Signal(Emitter::*)(Args...)) <= 2*sizeof(void*),
+        "Size of member function pointer is incorrectly assumed to be smaller than 2*sizeof(void*)");
+    static_assert(std::is_base_of<Emitter, EmitterObject>::value,
+        "Emitter object doesn't have given signal");
+    static_assert(std::is_base_of<Receiver, ReceiverObject>::value,
+        "Receiver object doesn't have given slot");
+
+    #ifndef CORRADE_MSVC2015_COMPATIBILITY
+    Implementation::SignalData signalData(signal);
+    #else
+    auto signalData = Implementation::SignalData::create<EmitterObject, Args...>(signal);
+    #endif
+    auto data = new Implementation::MemberConnectionData<ReceiverObject, void, Args...>(&emitter, &receiver, slot, Interconnect::Emitter::eventQueueInternal(receiver));
+    Interconnect::Emitter::connectInternal(signalData, data);
+    return Connection(data);
+}
+
+/**
+@brief Connect signal to another signal
+@param emitter       Emitter
+@param signal        Signal
+@param target        Target emitter
+@param targetSignal  Target signal
+
+Emitting @p signal emits also @p targetSignal on @p target with the same
+arguments. Unlike connecting a @ref Receiver slot that emits the target
+signal, the target signal is emitted directly from the emission, without any
+intermediate object. @p target must be subclass of @ref Emitter, the argument
+count and types of both signals must be exactly the same.
+
+The connection is automatically removed when either of the emitters is
+destroyed. See @ref Interconnect-Emitter-forwarding "Emitter class documentation"
+for more information about signal forwarding.
+
+@see @ref Emitter::hasSignalConnections(), @ref Connection::isConnected(),
+     @ref Emitter::signalConnectionCount()
+*/
+template<class EmitterObject, class Emitter, class TargetObject, class Target, class ...Args> Connection connect(EmitterObject& emitter, Interconnect::Emitter::Signal(Emitter::*signal)(Args...), TargetObject& target, Interconnect::Emitter::Signal(Target::*targetSignal)(Args...)) {
+    static_assert(sizeof(Interconnect::Emitter::Signal(Emitter::*)(Args...)) <= 2*sizeof(void*),
+        "Size of member function pointer is incorrectly assumed to be smaller than 2*sizeof(void*)");
+    static_assert(std::is_base_of<Emitter, EmitterObject>::value,
+        "Emitter object doesn't have given signal");
+    static_assert(std::is_base_of<Target, TargetObject>::value,
+        "Target emitter object doesn't have given signal");
+
+    #ifndef CORRADE_MSVC2015_COMPATIBILITY
+    Implementation::SignalData signalData(signal);
+    Implementation::SignalData targetSignalData(targetSignal);
+    #else
+    auto signalData = Implementation::SignalData::create<EmitterObject, Args...>(signal);
+    auto targetSignalData = Implementation::SignalData::create<TargetObject, Args...>(targetSignal);
+    #endif
+    auto data = new Implementation::SignalConnectionData(&emitter, &target, targetSignalData);
+    Interconnect::Emitter::connectInternal(signalData, data);
+    return Connection(data);
 }
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
-template<class Emitter_, class ...Args> Emitter::Signal Emitter::emit(Signal(Emitter_::*signal)(Args...), typename std::common_type<Args>::type... args) {
-    connectionsChanged = false;
-    ++lastHandledSignal;
-    auto range = connections.equal_range(
-        #ifndef CORRADE_MSVC2015_COMPATIBILITY
-        Implementation::SignalData(signal)
-        #else
-        Implementation::SignalData::create<Emitter_, Args...>(signal)
+template<class ...Args> bool Emitter::handleInternal(Implementation::AbstractConnectionData* const data, const Implementation::ForwardingChain* const chain, Args... args) {
+    switch(data->type) {
+        case Implementation::AbstractConnectionData::Type::Function:
+            return static_cast<Implementation::FunctionConnectionData<Args...>*>(data)->handle(args...);
+        case Implementation::AbstractConnectionData::Type::Functor:
+            return static_cast<Implementation::FunctorConnectionData<Args...>*>(data)->handle(args...);
+        case Implementation::AbstractConnectionData::Type::Member:
+            return static_cast<Implementation::BaseMemberConnectionData<Args...>*>(data)->handle(args...);
+        case Implementation::AbstractConnectionData::Type::Queued:
+            static_cast<Implementation::AbstractMemberConnectionData*>(data)->queue->push(new Implementation::QueuedEventData<Args...>{data, args...});
+            return false;
+        case Implementation::AbstractConnectionData::Type::Signal: {
+            /* Signal already being emitted by this chain of forwarding
+               connections is not emitted again */
+            auto forwardingData = static_cast<Implementation::SignalConnectionData*>(data);
+            if(isForwardingCycleInternal(forwardingData, chain)) return false;
+
+            const Implementation::ForwardingChain next{forwardingData, chain};
+            forwardingData->target->emitSignalInternal<Args...>(forwardingData->targetSignal, &next, args...);
+            return false;
+        }
+    }
+
+    CORRADE_ASSERT_UNREACHABLE();
+}
+
+template<class ...Args> void Emitter::emitThreadSafeInternal(const Implementation::SignalData& signal, const Implementation::ForwardingChain* const chain, Args... args) {
+    /* Thread-safe emitters walk the current snapshot, which can't change
+       underneath */
+    #ifdef CORRADE_BUILD_INTERCONNECT_PROFILING
+    Implementation::EmissionProfiler profiler{*this, signal};
+    #endif
+    std::uint32_t epoch;
+    const Implementation::ConnectionSnapshot* const snapshot = beginEmission(epoch);
+    if(const Implementation::SignalConnections* const signalConnections = snapshot->find(signal))
+        for(Implementation::AbstractConnectionData* const data: signalConnections->connections) {
+            const bool consumed = handleInternal<Args...>(data, chain, args...);
+            #ifdef CORRADE_BUILD_INTERCONNECT_PROFILING
+            ++profiler.slotCallCount;
+            #endif
+            if(consumed) break;
+        }
+    endEmission(epoch);
+}
+
+template<class ...Args> void Emitter::emitSignalInternal(const Implementation::SignalData& signal, const Implementation::ForwardingChain* const chain, Args... args) {
+    if(threadSafety) emitThreadSafeInternal<Args...>(signal, chain, args...);
+    else emitInternal<Args...>(signal, findSignalConnections(signal), chain, args...);
+}
+
+template<class ...Args> void Emitter::emitInternal(const Implementation::SignalData& signal, Implementation::SignalConnections* signalConnections, const Implementation::ForwardingChain* const chain, Args... args) {
+    #ifdef CORRADE_BUILD_INTERCONNECT_PROFILING
+    Implementation::EmissionProfiler profiler{*this, signal};
+    #endif
+    if(!signalConnections) return;
+
+    /* Connections added or reprioritized during previous emission are sorted
+       only now, to not shift them under that emission */
+    if(!emissionDepth && !signalConnections->sorted)
+        sortInternal(*signalConnections);
+
+    /* Slots can connect and disconnect anything. Removed connections are
+       replaced with nullptr and skipped, new ones are appended and thus also
+       called, so every connection is visited exactly once. The slot array is
+       accessed by index as it might get reallocated by the slot. */
+    ++emissionDepth;
+    Implementation::AbstractConnectionData* const* slots = signalConnections->connections.data();
+    std::size_t slotCount = signalConnections->connections.size();
+    for(std::size_t i = 0; i < slotCount; ++i) {
+        Implementation::AbstractConnectionData* const data = slots[i];
+        if(!data) continue;
+
+        /* Direct slot calls are dispatched here so they're inlined into the
+           loop, queued and forwarded connections go through the rest of
+           handleInternal() */
+        const std::uint32_t generation = slotGeneration;
+        bool consumed;
+        switch(data->type) {
+            case Implementation::AbstractConnectionData::Type::Function:
+                consumed = static_cast<Implementation::FunctionConnectionData<Args...>*>(data)->handle(args...);
+                break;
+            case Implementation::AbstractConnectionData::Type::Functor:
+                consumed = static_cast<Implementation::FunctorConnectionData<Args...>*>(data)->handle(args...);
+                break;
+            case Implementation::AbstractConnectionData::Type::Member:
+                consumed = static_cast<Implementation::BaseMemberConnectionData<Args...>*>(data)->handle(args...);
+                break;
+            default:
+                consumed = handleInternal<Args...>(data, chain, args...);
+        }
+        #ifdef CORRADE_BUILD_INTERCONNECT_PROFILING
+        ++profiler.slotCallCount;
         #endif
-        );
-    auto it = range.first;
-    while(it != range.second) {
-        /* If not already handled, proceed and mark as such */
-        if(it->second->lastHandledSignal != lastHandledSignal) {
-            it->second->lastHandledSignal = lastHandledSignal;
-            switch(it->second->type) {
-                case Implementation::AbstractConnectionData::Type::Function:
-                    static_cast<Implementation::FunctionConnectionData<Args...>*>(it->second)->handle(args...);
-                    break;
-                case Implementation::AbstractConnectionData::Type::Member:
-                    static_cast<Implementation::BaseMemberConnectionData<Args...>*>(it->second)->handle(args...);
-                    break;
-                default:
-                    CORRADE_ASSERT_UNREACHABLE();
-            }
-
-            /* Connections changed by the slot, go through again */
-            if(connectionsChanged) {
-                range = connections.equal_range(
-                    #ifndef CORRADE_MSVC2015_COMPATIBILITY
-                    Implementation::SignalData(signal)
-                    #else
-                    Implementation::SignalData::create<Emitter_, Args...>(signal)
-                    #endif
-                    );
-                it = range.first;
-                connectionsChanged = false;
-                continue;
-            }
-        }
-
-        /* Nothing called or changed, next connection */
-        ++it;
+
+        /* The slot consumed the signal, don't call the remaining ones */
+        if(consumed) break;
+
+        /* The slot connected something or disconnected a whole signal, the
+           slot array might have been reallocated, cleared or appended to.
+           If a signal entry was added, ours also moved. */
+        if(generation != slotGeneration) {
+            signalConnections = findSignalConnections(signal);
+            slots = signalConnections->connections.data();
+            slotCount = signalConnections->connections.size();
+        }
+    }
+    if(!--emissionDepth && !dirtySignals.empty()) compactDirtyInternal();
+}
+
+inline Implementation::SignalConnections* Emitter::findSignalConnections(const Implementation::SignalData& signal) {
+    /* Binary search, inline as it's done on every emit() */
+    Implementation::SignalConnections* found = connections.data();
+    Implementation::SignalConnections* const end = found + connections.size();
+    for(std::size_t count = connections.size(); count; ) {
+        const std::size_t half = count/2;
+        if(found[half].signal < signal) {
+            found += half + 1;
+            count -= half + 1;
+        } else count = half;
+    }
+    return found != end && found->signal == signal ? found : nullptr;
+}
+
+inline Implementation::SignalConnections* Emitter::findSignalConnections(const std::size_t index, const Implementation::SignalData& signal) {
+    /* The signal is checked whenever the slot is occupied, even if the
+       cached position is stale already */
+    if(index < signalIndices.size() && signalIndices[index].generation) {
+        const Implementation::SignalIndex& signalIndex = signalIndices[index];
+        CORRADE_ASSERT(signalIndex.signal == signal,
+            "Interconnect::Emitter::emit(): signal index" << index << "is already used by another signal", nullptr);
+        if(signalIndex.generation == signalGeneration + 1)
+            return signalIndex.position == ~std::size_t{} ? nullptr : &connections[signalIndex.position];
+    }
+
+    return cacheSignalIndexInternal(index, signal);
+}
+
+template<class Emitter_, class ...Args> Emitter::Signal Emitter::emit(Signal(Emitter_::*signal)(Args...), typename std::common_type<Args>::type... args) {
+    #ifndef CORRADE_MSVC2015_COMPATIBILITY
+    const Implementation::SignalData signalData(signal);
+    #else
+    const auto signalData = Implementation::SignalData::create<Emitter_, Args...>(signal);
+    #endif
+
+    emitSignalInternal<Args...>(signalData, nullptr, args...);
+    return Signal();
+}
+
+template<std::size_t index, class Emitter_, class ...Args> Emitter::Signal Emitter::emit(Signal(Emitter_::*signal)(Args...), typename std::common_type<Args>::type... args) {
+    #ifndef CORRADE_MSVC2015_COMPATIBILITY
+    const Implementation::SignalData signalData(signal);
+    #else
+    const auto signalData = Implementation::SignalData::create<Emitter_, Args...>(signal);
+    #endif
+
+    /* The cache would need synchronization in thread-safe emitters and
+       searching the snapshot is cheap compared to that */
+    if(threadSafety) emitThreadSafeInternal<Args...>(signalData, nullptr, args...);
+    else emitInternal<Args...>(signalData, findSignalConnections(index, signalData), nullptr, args...);
+    return Signal();
+}
+
+template<class Emitter_, class ...Args> Emitter::Signal Emitter::emitDeferred(Signal(Emitter_::*signal)(Args...), typename std::common_type<Args>::type... args) {
+    #ifndef CORRADE_MSVC2015_COMPATIBILITY
+    const Implementation::SignalData signalData(signal);
+    #else
+    const auto signalData = Implementation::SignalData::create<Emitter_, Args...>(signal);
+    #endif
+
+    /* If the signal is already pending, just replace the arguments. There's
+       usually only a handful of pending signals, so linear search is fine. */
+    for(Implementation::DeferredEmission* const emission: deferredEmissions) {
+        if(emission->signal != signalData) continue;
+
+        static_cast<Implementation::DeferredEmissionData<Args...>*>(emission)->arguments = std::tuple<typename std::decay<Args>::type...>{args...};
+        return Signal();
     }
 
+    deferredEmissions.push_back(new Implementation::DeferredEmissionData<Args...>{signalData, args...});
     return Signal();
 }
 #endif
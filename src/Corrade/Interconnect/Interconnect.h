@@ -36,8 +36,10 @@ namespace Corrade { namespace Interconnect {
 class Connection;
 class Emitter;
 class Receiver;
+template<class...> class SignalWaiter;
 
 template<std::size_t, std::size_t, class, class> class StateMachine;
+template<std::size_t, std::size_t, class, class> class StateTransitionTable;
 
 }}
 
@@ -33,18 +33,39 @@
 
 namespace Corrade { namespace Interconnect {
 
-Receiver::Receiver() = default;
+Receiver::Receiver(): queue(nullptr) {}
+
+Receiver::Receiver(Receiver&& other) noexcept: connections{std::move(other.connections)}, queue{other.queue} {
+    other.connections.clear();
+    other.queue = nullptr;
+    moveInternal();
+}
+
+Receiver& Receiver::operator=(Receiver&& other) noexcept {
+    std::swap(connections, other.connections);
+    std::swap(queue, other.queue);
+    moveInternal();
+    other.moveInternal();
+    return *this;
+}
+
+void Receiver::moveInternal() {
+    /* Queued events reference the connection data and not the receiver, so
+       only the connection data need to be updated */
+    for(Implementation::AbstractConnectionData* data: connections)
+        static_cast<Implementation::AbstractMemberConnectionData*>(data)->receiver = this;
+}
 
 Receiver::~Receiver() {
+    /* Drop pending events, the slots can't be called anymore */
+    if(queue) {
+        queue->close();
+        Implementation::releaseEventQueue(queue);
+    }
+
     for(auto end = connections.end(), it = connections.begin(); it != end; ++it) {
         /* Remove connection from emitter */
-        for(auto eend = (*it)->emitter->connections.end(), eit = (*it)->emitter->connections.begin(); eit != eend; ++eit) {
-            if(eit->second != *it) continue;
-
-            (*it)->emitter->connections.erase(eit);
-            (*it)->emitter->connectionsChanged = true;
-            break;
-        }
+        Emitter::eraseInternal(*it);
 
         /* If there is connection object, remove reference to connection data
            from it and mark it as disconnected */
@@ -55,24 +76,18 @@ Receiver::~Receiver() {
         }
 
         /* Delete connection data (as they make no sense without receiver) */
-        delete *it;
+        Implementation::releaseConnectionData(*it);
     }
 }
 
 void Receiver::disconnectAllSlots() {
     for(auto it = connections.begin(); it != connections.end(); ++it) {
         /* Remove connection from emitter */
-        for(auto end = (*it)->emitter->connections.end(), eit = (*it)->emitter->connections.begin(); eit != end; ++eit) {
-            if(eit->second != *it) continue;
-
-            (*it)->emitter->connections.erase(eit);
-            (*it)->emitter->connectionsChanged = true;
-            break;
-        }
+        Emitter::eraseInternal(*it);
 
         /* If there is no connection object, destroy also connection data (as we
            are the last remaining owner) */
-        if(!(*it)->connection) delete *it;
+        if(!(*it)->connection) Implementation::releaseConnectionData(*it);
 
         /* Else mark the connection as disconnected */
         else (*it)->connection->connected = false;
@@ -81,4 +96,34 @@ void Receiver::disconnectAllSlots() {
     connections.clear();
 }
 
+std::size_t Receiver::dispatchQueued() {
+    if(!queue) return 0;
+
+    /* Keep the queue alive in case the receiver gets deleted in a slot */
+    Implementation::EventQueue* const queue = this->queue;
+    ++queue->references;
+
+    std::size_t count = 0;
+    Implementation::QueuedEvent* event = queue->take();
+    while(event) {
+        Implementation::QueuedEvent* const next = event->next;
+
+        /* Call the slot only if the receiver still exists and the connection
+           wasn't removed since the emission, not even temporarily */
+        if(!queue->closed.load()) {
+            auto data = static_cast<Implementation::AbstractMemberConnectionData*>(event->data);
+            if(data->receiverIndex < connections.size() && connections[data->receiverIndex] == data && data->epoch.load(std::memory_order_relaxed) == event->epoch) {
+                event->dispatch();
+                ++count;
+            }
+        }
+
+        delete event;
+        event = next;
+    }
+
+    Implementation::releaseEventQueue(queue);
+    return count;
+}
+
 }}
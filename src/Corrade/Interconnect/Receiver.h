@@ -39,6 +39,7 @@ namespace Corrade { namespace Interconnect {
 
 namespace Implementation {
     class AbstractConnectionData;
+    class EventQueue;
 }
 
 /**
@@ -46,7 +47,6 @@ namespace Implementation {
 
 Contains member function slots. See @ref interconnect for introduction.
 @see @ref Emitter, @ref Connection
-@todo Allow move
 */
 class CORRADE_INTERCONNECT_EXPORT Receiver {
     friend Implementation::AbstractConnectionData;
@@ -58,14 +58,26 @@ class CORRADE_INTERCONNECT_EXPORT Receiver {
         /** @brief Copying is not allowed */
         Receiver(const Receiver&) = delete;
 
-        /** @brief Moving is not allowed */
-        Receiver(Receiver&&) = delete;
+        /**
+         * @brief Move constructor
+         *
+         * All connections and pending queued slot calls are transferred to
+         * the new instance without reconnecting, @p other is left without
+         * any connections. The receiver can't be moved while its slots are
+         * being called.
+         */
+        Receiver(Receiver&& other) noexcept;
 
         /** @brief Copying is not allowed */
         Receiver& operator=(const Receiver&) = delete;
 
-        /** @brief Moving is not allowed */
-        Receiver& operator=(Receiver&&) = delete;
+        /**
+         * @brief Move assignment
+         *
+         * Swaps the connections and pending queued slot calls with @p other.
+         * See @ref Receiver(Receiver&&) for details.
+         */
+        Receiver& operator=(Receiver&& other) noexcept;
 
         /**
          * @brief Whether the receiver is connected to any signal
@@ -94,13 +106,32 @@ class CORRADE_INTERCONNECT_EXPORT Receiver {
          */
         void disconnectAllSlots();
 
+        /**
+         * @brief Dispatch queued slot calls
+         * @return Count of called slots
+         *
+         * Calls slots of all @ref Interconnect-Emitter-queued "queued connections"
+         * for signals emitted since the last call, in order of emission.
+         * Calls for connections that were removed in the meantime are
+         * skipped. Signals emitted by the slots are dispatched in the next
+         * call. It is safe to delete the receiver in a slot, the remaining
+         * calls are skipped then.
+         *
+         * Only a single thread can dispatch at a time, but signals can be
+         * emitted from any thread meanwhile.
+         */
+        std::size_t dispatchQueued();
+
     protected:
         /* Nobody will need to have (and delete) Receiver*, thus this is faster
            than public pure virtual destructor */
         ~Receiver();
 
     private:
+        void moveInternal();
+
         std::vector<Implementation::AbstractConnectionData*> connections;
+        Implementation::EventQueue* queue;
 };
 
 }}
@@ -0,0 +1,168 @@
+#ifndef Corrade_Interconnect_SignalWaiter_h
+#define Corrade_Interconnect_SignalWaiter_h
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Corrade::Interconnect::SignalWaiter
+ */
+
+#include <new>
+#include <tuple>
+#include <type_traits>
+
+#include "Corrade/Interconnect/Emitter.h"
+
+namespace Corrade { namespace Interconnect {
+
+/**
+@brief Waiter for next signal emission
+
+Connects to given signal and stores the arguments of its next emission,
+disconnecting itself afterwards. The arguments are stored directly in the
+waiter and the connection is a function object connection small enough to not
+need any additional allocation, so waiting doesn't allocate anything except
+the connection data itself.
+
+@code
+Interconnect::SignalWaiter<int> waiter{postman, &Postman::paymentRequested};
+
+// ...
+
+if(waiter.isReady()) Utility::Debug() << std::get<0>(waiter.arguments());
+@endcode
+
+## Usage with coroutines
+
+The waiter implements the awaitable interface, so it can be directly used in
+a `co_await` expression of a C++20 coroutine. The coroutine is resumed from
+inside the emission with the signal arguments as a @ref std::tuple:
+@code
+Task waitForPayment(Postman& postman) {
+    int amount;
+    std::tie(amount) = co_await Interconnect::SignalWaiter<int>{postman, &Postman::paymentRequested};
+    // ...
+}
+@endcode
+
+If the emitter is destroyed before emitting the signal, the waiter never
+becomes ready.
+
+@attention The waiter is not synchronized in any way, so it's meant to be used
+    only with signals emitted from a single thread.
+*/
+template<class ...Args> class SignalWaiter {
+    public:
+        /** @brief Stored signal arguments */
+        typedef std::tuple<typename std::decay<Args>::type...> Arguments;
+
+        /**
+         * @brief Constructor
+         * @param emitter   Emitter
+         * @param signal    Signal
+         *
+         * Connects to the signal. If the signal is emitted more than once
+         * before the waiter is destroyed, only the first emission is
+         * recorded.
+         */
+        template<class EmitterObject, class Emitter> explicit SignalWaiter(EmitterObject& emitter, Interconnect::Emitter::Signal(Emitter::*signal)(Args...)): _ready{false}, _resume{}, _coroutine{}, _connection{Interconnect::connect(emitter, signal, [this](Args... args) { emitted(args...); })} {}
+
+        /** @brief Copying is not allowed */
+        SignalWaiter(const SignalWaiter<Args...>&) = delete;
+
+        /** @brief Moving is not allowed */
+        SignalWaiter(SignalWaiter<Args...>&&) = delete;
+
+        /**
+         * @brief Destructor
+         *
+         * Disconnects from the signal, if it wasn't emitted yet.
+         */
+        ~SignalWaiter() {
+            _connection.disconnect();
+            if(_ready) reinterpret_cast<Arguments*>(&_arguments)->~Arguments();
+        }
+
+        /** @brief Copying is not allowed */
+        SignalWaiter<Args...>& operator=(const SignalWaiter<Args...>&) = delete;
+
+        /** @brief Moving is not allowed */
+        SignalWaiter<Args...>& operator=(SignalWaiter<Args...>&&) = delete;
+
+        /** @brief Whether the signal was emitted */
+        bool isReady() const { return _ready; }
+
+        /**
+         * @brief Signal arguments
+         *
+         * Expects that the signal was already emitted.
+         * @see @ref isReady()
+         */
+        Arguments& arguments() {
+            CORRADE_ASSERT(_ready, "Interconnect::SignalWaiter::arguments(): the signal wasn't emitted yet", *reinterpret_cast<Arguments*>(&_arguments));
+            return *reinterpret_cast<Arguments*>(&_arguments);
+        }
+
+        /** @brief Whether the coroutine doesn't need to be suspended */
+        bool await_ready() const { return _ready; }
+
+        /**
+         * @brief Suspend a coroutine until the signal is emitted
+         *
+         * The @p coroutine is expected to be a coroutine handle, i.e. having
+         * an `address()` and a static `from_address()` function and a
+         * `resume()` function. It's resumed from inside the emission.
+         */
+        template<class Handle> void await_suspend(Handle coroutine) {
+            _coroutine = coroutine.address();
+            _resume = [](void* coroutine) { Handle::from_address(coroutine).resume(); };
+        }
+
+        /** @brief Signal arguments for the resumed coroutine */
+        Arguments await_resume() { return std::move(arguments()); }
+
+    private:
+        void emitted(Args... args) {
+            if(_ready) return;
+
+            new(&_arguments) Arguments{args...};
+            _ready = true;
+            _connection.disconnect();
+
+            /* The coroutine might destroy the waiter, so this has to be the
+               last thing done */
+            if(_resume) _resume(_coroutine);
+        }
+
+        typename std::aligned_storage<sizeof(Arguments), alignof(Arguments)>::type _arguments;
+        bool _ready;
+        void(*_resume)(void*);
+        void* _coroutine;
+        Connection _connection;
+};
+
+}}
+
+#endif
@@ -25,10 +25,20 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "Corrade/Containers/ArrayView.h"
 #include "Corrade/Interconnect/Emitter.h"
 
 namespace Corrade { namespace Interconnect {
 
+namespace Implementation {
+    template<class, class> struct StateMachineSignals;
+    template<class, class, std::size_t, class> struct StateMachineSteppedSignals;
+}
+
 /**
 @brief Transition between states
 
@@ -36,6 +46,7 @@ See @ref StateMachine for more information.
 */
 template<class State, class Input> class StateTransition {
     template<std::size_t, std::size_t, class, class> friend class StateMachine;
+    template<std::size_t, std::size_t, class, class> friend class StateTransitionTable;
 
     public:
         /** @brief Constructor */
@@ -47,6 +58,164 @@ template<class State, class Input> class StateTransition {
         State to;
 };
 
+/**
+@brief Parent of a state
+
+See @ref StateTransitionTable for more information.
+*/
+template<class State> class StateParent {
+    template<std::size_t, std::size_t, class, class> friend class StateTransitionTable;
+
+    public:
+        /** @brief Constructor */
+        constexpr /*implicit*/ StateParent(State state, State parent): state(state), parent(parent) {}
+
+    private:
+        State state;
+        State parent;
+};
+
+/**
+@brief Compile-time state transition table
+
+A table of transitions for @ref StateMachine that's built entirely at compile
+time. Defining it as a @cpp constexpr @ce global puts it into read-only memory
+and all machines constructed from it with
+@ref StateMachine::StateMachine(const StateTransitionTable<states, inputs, State, Input>&)
+share it instead of each having its own copy.
+
+@code
+constexpr StateTransition<State, Input> PrinterTransitions[]{
+    {State::Ready,      Input::Operate,         State::Printing},
+    {State::Printing,   Input::Operate,         State::Finished},
+    {State::Finished,   Input::RemoveDocument,  State::Ready}
+};
+constexpr StateTransitionTable<3, 2, State, Input> PrinterTable{PrinterTransitions};
+
+Printer a{PrinterTable}, b{PrinterTable};
+@endcode
+
+@anchor Interconnect-StateTransitionTable-hierarchical-states
+## Hierarchical states
+
+States can be nested by assigning them a parent state. If a state has no
+transition for given input, the transition of its parent is used, then of the
+parent's parent and so on. That way transitions common to a group of states
+need to be listed only once. The lookup is resolved at compile time, so
+stepping the machine is a single lookup.
+
+Note that the hierarchy only makes the transition @e list shorter, the
+storage is not affected by it. The table always stores the resolved
+transition for every state and input, i.e. @cpp states*inputs*sizeof(State) @ce
+bytes, the same as a flat machine. Every @ref StateMachine additionally
+reserves the same amount for transitions added with
+@ref StateMachine::addTransitions(), even if it uses a shared table.
+
+@code
+constexpr StateParent<State> PrinterParents[]{
+    {State::Printing,   State::Busy},
+    {State::Finished,   State::Busy}
+};
+constexpr StateTransition<State, Input> PrinterTransitions[]{
+    // applies to both Printing and Finished
+    {State::Busy,       Input::Cancel,          State::Ready},
+    ...
+};
+constexpr StateTransitionTable<4, 3, State, Input> PrinterTable{PrinterTransitions, PrinterParents};
+@endcode
+
+The parent relations are expected to form a tree. The signals emitted by
+@ref StateMachine are not affected by the hierarchy --- only the states
+actually entered and exited emit @ref StateMachine::entered() and
+@ref StateMachine::exited().
+*/
+template<std::size_t states, std::size_t inputs, class State, class Input> class StateTransitionTable {
+    template<std::size_t, std::size_t, class, class> friend class StateMachine;
+
+    public:
+        /**
+         * @brief Default constructor
+         *
+         * All states are no-op (i.e., given state will not be changed to
+         * anything else for any input).
+         */
+        constexpr explicit StateTransitionTable(): StateTransitionTable{nullptr, 0, nullptr, 0, typename Utility::Implementation::GenerateSequence<states>::Type{}} {}
+
+        /**
+         * @brief Construct from a list of transitions
+         *
+         * Transitions that are not listed are no-op. If there is more than
+         * one transition for the same state and input, the last one is used.
+         */
+        template<std::size_t size> constexpr explicit StateTransitionTable(const StateTransition<State, Input>(&transitions)[size]): StateTransitionTable{transitions, size, nullptr, 0, typename Utility::Implementation::GenerateSequence<states>::Type{}} {}
+
+        /**
+         * @brief Construct from a list of transitions and state parents
+         *
+         * If a state has no transition for given input, the transition of
+         * its parent is used. See @ref Interconnect-StateTransitionTable-hierarchical-states "class documentation"
+         * for more information.
+         */
+        template<std::size_t size, std::size_t parentCount> constexpr explicit StateTransitionTable(const StateTransition<State, Input>(&transitions)[size], const StateParent<State>(&parents)[parentCount]): StateTransitionTable{transitions, size, parents, parentCount, typename Utility::Implementation::GenerateSequence<states>::Type{}} {}
+
+        /** @brief State after given input */
+        constexpr State operator()(State state, Input input) const {
+            return _rows[std::size_t(state)].to[std::size_t(input)];
+        }
+
+    private:
+        struct Row { State to[inputs]; };
+
+        template<std::size_t ...state> constexpr explicit StateTransitionTable(const StateTransition<State, Input>* transitions, std::size_t size, const StateParent<State>* parents, std::size_t parentCount, Utility::Implementation::Sequence<state...>): _rows{row(transitions, size, parents, parentCount, State(state), typename Utility::Implementation::GenerateSequence<inputs>::Type{})...} {}
+
+        template<std::size_t ...input> constexpr static Row row(const StateTransition<State, Input>* transitions, std::size_t size, const StateParent<State>* parents, std::size_t parentCount, State state, Utility::Implementation::Sequence<input...>) {
+            return Row{{transition(transitions, size, parents, parentCount, state, state, Input(input))...}};
+        }
+
+        /* C++11 constexpr functions are a single return statement, so the
+           lookup is split into a chain of recursive functions. The ranges
+           are halved on every level to keep the recursion depth logarithmic
+           in the transition count, as compilers limit constexpr recursion
+           to a few hundred levels. The upper half is searched first so the
+           last matching transition wins, same as with
+           StateMachine::addTransitions(). */
+        constexpr static std::size_t findTransition(const StateTransition<State, Input>* transitions, std::size_t begin, std::size_t end, State state, Input input) {
+            return end - begin == 0 ? ~std::size_t{} :
+                end - begin == 1 ? (transitions[begin].from == state && transitions[begin].input == input ? begin : ~std::size_t{}) :
+                findTransitionLower(transitions, begin, begin + (end - begin)/2, state, input, findTransition(transitions, begin + (end - begin)/2, end, state, input));
+        }
+
+        constexpr static std::size_t findTransitionLower(const StateTransition<State, Input>* transitions, std::size_t begin, std::size_t middle, State state, Input input, std::size_t found) {
+            return found != ~std::size_t{} ? found : findTransition(transitions, begin, middle, state, input);
+        }
+
+        constexpr static std::size_t findParent(const StateParent<State>* parents, std::size_t begin, std::size_t end, State state) {
+            return end - begin == 0 ? ~std::size_t{} :
+                end - begin == 1 ? (parents[begin].state == state ? begin : ~std::size_t{}) :
+                findParentLower(parents, begin, begin + (end - begin)/2, state, findParent(parents, begin + (end - begin)/2, end, state));
+        }
+
+        constexpr static std::size_t findParentLower(const StateParent<State>* parents, std::size_t begin, std::size_t middle, State state, std::size_t found) {
+            return found != ~std::size_t{} ? found : findParent(parents, begin, middle, state);
+        }
+
+        constexpr static State transition(const StateTransition<State, Input>* transitions, std::size_t size, const StateParent<State>* parents, std::size_t parentCount, State from, State state, Input input) {
+            return transitionFound(transitions, size, parents, parentCount, from, state, input, findTransition(transitions, 0, size, state, input));
+        }
+
+        constexpr static State transitionFound(const StateTransition<State, Input>* transitions, std::size_t size, const StateParent<State>* parents, std::size_t parentCount, State from, State state, Input input, std::size_t found) {
+            return found != ~std::size_t{} ? transitions[found].to :
+                parentFound(transitions, size, parents, parentCount, from, input, findParent(parents, 0, parentCount, state));
+        }
+
+        constexpr static State parentFound(const StateTransition<State, Input>* transitions, std::size_t size, const StateParent<State>* parents, std::size_t parentCount, State from, Input input, std::size_t found) {
+            return found == ~std::size_t{} ? from :
+                transition(transitions, size, parents, parentCount, from, parents[found].parent, input);
+        }
+
+        Row _rows[states];
+};
+
 /**
 @brief State machine
 
@@ -109,8 +278,18 @@ p.step(Input::Remove);
     Print finished. Please remove the document.
     Printer is ready.
 
+## Compile-time transition tables
+
+Instead of adding the transitions at runtime, the machine can be constructed
+from a @ref StateTransitionTable built at compile time. The table is then
+shared by all machines constructed from it, which also allows grouping states
+hierarchically. See its documentation for more information.
+
 */
 template<std::size_t states, std::size_t inputs, class State, class Input> class StateMachine: public Emitter {
+    template<class, class> friend struct Implementation::StateMachineSignals;
+    template<class, class, std::size_t, class> friend struct Implementation::StateMachineSteppedSignals;
+
     public:
         enum: std::size_t {
             StateCount = states, /**< @brief Count of states in the machine */
@@ -125,6 +304,35 @@ template<std::size_t states, std::size_t inputs, class State, class Input> class
          */
         explicit StateMachine();
 
+        /**
+         * @brief Construct from a transition table
+         *
+         * The machine references the @p table instead of using its own
+         * transitions, so it's expected to be alive for the whole machine
+         * lifetime. Calling @ref addTransitions() later copies the table into
+         * the machine first, leaving the original unchanged.
+         * @see @ref StateTransitionTable
+         */
+        explicit StateMachine(const StateTransitionTable<states, inputs, State, Input>& table);
+
+        /**
+         * @brief Construct from a temporary transition table
+         *
+         * Not allowed, as the machine would reference a destroyed table.
+         */
+        explicit StateMachine(const StateTransitionTable<states, inputs, State, Input>&&) = delete;
+
+        /**
+         * @brief Move constructor
+         *
+         * Transfers the transitions, current state and all connections,
+         * see @ref Emitter::Emitter(Emitter&&) for details.
+         */
+        StateMachine(StateMachine<states, inputs, State, Input>&& other) noexcept;
+
+        /** @brief Move assignment */
+        StateMachine<states, inputs, State, Input>& operator=(StateMachine<states, inputs, State, Input>&& other) noexcept;
+
         /**
          * @brief Current state
          *
@@ -146,10 +354,25 @@ template<std::size_t states, std::size_t inputs, class State, class Input> class
          *
          * Switches current state based on the @p input. If the new state is
          * different from previous one, emits @ref exited() with the old state
-         * and then @ref entered() with the new one.
+         * and then @ref entered() with the new one. The machine keeps track
+         * of which states have any connections, so signals without
+         * connections don't cost anything.
          */
         StateMachine<states, inputs, State, Input>& step(Input input);
 
+        /**
+         * @brief Step the machine over a sequence of inputs
+         * @return Reference to self (for method chaining)
+         *
+         * Equivalent to calling @ref step(Input) for each item of
+         * @p sequence. Runs of inputs that don't lead to any connected
+         * signal are walked directly in the transition table with only a
+         * listener mask check per input, @ref step(Input) is called only
+         * for the transitions that emit something. Thread-safe machines
+         * can't skip anything and step through all inputs one by one.
+         */
+        StateMachine<states, inputs, State, Input>& step(Containers::ArrayView<const Input> sequence);
+
         /**
          * @brief The machine is switching states
          *
@@ -196,50 +419,54 @@ template<std::size_t states, std::size_t inputs, class State, class Input> class
         }
 
     private:
-        State& at(State current, Input input) {
-            return _transitions[std::size_t(current)*inputs+std::size_t(input)];
-        }
+        typedef StateTransitionTable<states, inputs, State, Input> TransitionTable;
 
-        const State& at(State current, Input input) const {
-            return _transitions[std::size_t(current)*inputs+std::size_t(input)];
+        State at(State current, Input input) const {
+            return _table ? (*_table)(current, input) : _transitions[std::size_t(current)*inputs + std::size_t(input)];
         }
 
-        template<std::size_t current> Signal enteredInternal(State wanted, std::integral_constant<std::size_t, current>, State previous) {
-            return State(current-1) == wanted ? entered<State(current-1)>(previous) : enteredInternal(wanted, std::integral_constant<std::size_t, current-1>{}, previous);
-        }
+        void resetTransitionsInternal();
 
-        Signal enteredInternal(State, std::integral_constant<std::size_t, 0>, State) {
-            CORRADE_ASSERT_UNREACHABLE();
-        }
+        /* Walks the transitions until one that has listeners, returning
+           where it stopped */
+        template<class Lookup> const Input* walkInternal(const Input* it, const Input* end, Lookup lookup);
 
-        template<std::size_t current> Signal steppedInternal(State wantedPrevious, std::integral_constant<std::size_t, current>, State next) {
-            return State(current-1) == wantedPrevious ?
-                steppedNextInternal<State(current-1)>(next, std::integral_constant<std::size_t, states>{}) :
-                steppedInternal(wantedPrevious, std::integral_constant<std::size_t, current-1>{}, next);
-        }
+        typedef Signal(StateMachine::*StateSignal)(State);
+        typedef Signal(StateMachine::*TransitionSignal)();
+        typedef Implementation::StateMachineSignals<StateMachine, typename Utility::Implementation::GenerateSequence<states>::Type> Signals;
 
-        Signal steppedInternal(State, std::integral_constant<std::size_t, 0>, State) {
-            CORRADE_ASSERT_UNREACHABLE();
-        }
+        enum: std::uint8_t {
+            ExitedListeners = 1 << 0,
+            SteppedListeners = 1 << 1,
+            EnteredListeners = 1 << 2
+        };
 
-        template<State previous, std::size_t current> Signal steppedNextInternal(State wantedNext, std::integral_constant<std::size_t, current>) {
-            return State(current-1) == wantedNext ? stepped<previous, State(current-1)>() : steppedNextInternal<previous>(wantedNext, std::integral_constant<std::size_t, current-1>{});
-        }
+        /* Which state signal has which listener bit, sorted by the signal
+           so the connection observer can find the affected state with a
+           binary search */
+        struct SignalListener {
+            Implementation::SignalData signal;
+            std::size_t state;
+            std::uint8_t listener;
+        };
 
-        template<State> Signal steppedNextInternal(State, std::integral_constant<std::size_t, 0>) {
-            CORRADE_ASSERT_UNREACHABLE();
-        }
+        static const std::vector<SignalListener>& signalListeners();
+        static void connectionObserverInternal(Emitter& emitter, const Implementation::SignalData& signal, bool connected);
 
-        template<std::size_t current> Signal exitedInternal(State wanted, std::integral_constant<std::size_t, current>, State next) {
-            return State(current-1) == wanted ? exited<State(current-1)>(next) : exitedInternal(wanted, std::integral_constant<std::size_t, current - 1>{}, next);
-        }
-
-        Signal exitedInternal(State, std::integral_constant<std::size_t, 0>, State) {
-            CORRADE_ASSERT_UNREACHABLE();
-        }
+        std::uint8_t listeners(State state) const;
 
+        /* Shared table the machine was constructed from, nullptr if it uses
+           its own transitions. Copied to _transitions on first
+           addTransitions(). */
+        const TransitionTable* _table;
         State _transitions[states*inputs];
         State _current;
+        /* Which of exited(), stepped() and entered() signals of given state
+           have any connections. Updated by the emitter connection observer
+           whenever a signal gets its first connection or loses the last one,
+           so step() doesn't need to look up signals that nobody listens
+           to. */
+        std::uint8_t _listeners[states];
 
    private:
         #ifdef _MSC_VER
@@ -253,33 +480,229 @@ template<std::size_t states, std::size_t inputs, class State, class Input> class
         #endif
 };
 
-template<std::size_t states, std::size_t inputs, class State, class Input> StateMachine<states, inputs, State, Input>::StateMachine(): _transitions{}, _current{} {
-    /* Make input in all states a no-op */
-    for(std::size_t i = 0; i != states; ++i)
-        for(std::size_t j = 0; j != inputs; ++j)
-            at(State(i), Input(j)) = State(i);
+namespace Implementation {
+
+/* Tables of signal pointers indexed by state, so step() doesn't need to
+   compare the states with all possible values to emit the right signals. The
+   tables are constant-initialized, there's no runtime setup. */
+template<class Machine, class StateType, std::size_t previous, std::size_t ...next> struct StateMachineSteppedSignals<Machine, StateType, previous, Utility::Implementation::Sequence<next...>> {
+    static const typename Machine::TransitionSignal stepped[sizeof...(next)];
+};
+
+template<class Machine, class StateType, std::size_t previous, std::size_t ...next> const typename Machine::TransitionSignal StateMachineSteppedSignals<Machine, StateType, previous, Utility::Implementation::Sequence<next...>>::stepped[]{
+    &Machine::template stepped<StateType(previous), StateType(next)>...
+};
+
+template<std::size_t states, std::size_t inputs, class State, class Input, std::size_t ...state> struct StateMachineSignals<StateMachine<states, inputs, State, Input>, Utility::Implementation::Sequence<state...>> {
+    typedef StateMachine<states, inputs, State, Input> Machine;
+
+    static const typename Machine::StateSignal entered[states];
+    static const typename Machine::StateSignal exited[states];
+    /* Indexed by previous and then next state */
+    static const typename Machine::TransitionSignal* const stepped[states];
+};
+
+template<std::size_t states, std::size_t inputs, class State, class Input, std::size_t ...state> const typename StateMachine<states, inputs, State, Input>::StateSignal StateMachineSignals<StateMachine<states, inputs, State, Input>, Utility::Implementation::Sequence<state...>>::entered[]{
+    &StateMachine<states, inputs, State, Input>::template entered<State(state)>...
+};
+
+template<std::size_t states, std::size_t inputs, class State, class Input, std::size_t ...state> const typename StateMachine<states, inputs, State, Input>::StateSignal StateMachineSignals<StateMachine<states, inputs, State, Input>, Utility::Implementation::Sequence<state...>>::exited[]{
+    &StateMachine<states, inputs, State, Input>::template exited<State(state)>...
+};
+
+template<std::size_t states, std::size_t inputs, class State, class Input, std::size_t ...state> const typename StateMachine<states, inputs, State, Input>::TransitionSignal* const StateMachineSignals<StateMachine<states, inputs, State, Input>, Utility::Implementation::Sequence<state...>>::stepped[]{
+    StateMachineSteppedSignals<StateMachine<states, inputs, State, Input>, State, state, Utility::Implementation::Sequence<state...>>::stepped...
+};
+
+}
+
+template<std::size_t states, std::size_t inputs, class State, class Input> StateMachine<states, inputs, State, Input>::StateMachine(): _table{}, _current{}, _listeners{} {
+    connectionObserver = connectionObserverInternal;
+    resetTransitionsInternal();
+}
+
+template<std::size_t states, std::size_t inputs, class State, class Input> StateMachine<states, inputs, State, Input>::StateMachine(const StateTransitionTable<states, inputs, State, Input>& table): _table{&table}, _transitions{}, _current{}, _listeners{} {
+    connectionObserver = connectionObserverInternal;
+}
+
+template<std::size_t states, std::size_t inputs, class State, class Input> StateMachine<states, inputs, State, Input>::StateMachine(StateMachine<states, inputs, State, Input>&& other) noexcept: Emitter{std::move(other)}, _table{other._table}, _current{other._current} {
+    connectionObserver = connectionObserverInternal;
+    for(std::size_t i = 0; i != states*inputs; ++i)
+        _transitions[i] = other._transitions[i];
+
+    /* The listener mask goes along with the connections, the moved-from
+       machine has none anymore */
+    for(std::size_t i = 0; i != states; ++i) {
+        _listeners[i] = other._listeners[i];
+        other._listeners[i] = 0;
+    }
+
+    /* The moved-from machine has no transitions anymore */
+    other._table = nullptr;
+    other.resetTransitionsInternal();
+}
+
+template<std::size_t states, std::size_t inputs, class State, class Input> StateMachine<states, inputs, State, Input>& StateMachine<states, inputs, State, Input>::operator=(StateMachine<states, inputs, State, Input>&& other) noexcept {
+    /* The listener masks go along with the swapped connections */
+    Emitter::operator=(std::move(other));
+    std::swap(_table, other._table);
+    std::swap(_transitions, other._transitions);
+    std::swap(_current, other._current);
+    std::swap(_listeners, other._listeners);
+    return *this;
 }
 
 template<std::size_t states, std::size_t inputs, class State, class Input> void StateMachine<states, inputs, State, Input>::addTransitions(const std::initializer_list<StateTransition<State, Input>> transitions) {
+    /* Copy the shared table on first modification */
+    if(_table) {
+        for(std::size_t i = 0; i != states; ++i)
+            for(std::size_t j = 0; j != inputs; ++j)
+                _transitions[i*inputs + j] = (*_table)(State(i), Input(j));
+        _table = nullptr;
+    }
+
     for(const auto transition: transitions) {
         CORRADE_ASSERT(std::size_t(transition.from) < states && std::size_t(transition.input) < inputs && std::size_t(transition.to) < states, "Interconnect::StateMachine: out-of-bounds state, from:" << std::size_t(transition.from) << "input:" << std::size_t(transition.input) << "to:" << std::size_t(transition.to), );
-        at(transition.from, transition.input) = transition.to;
+        _transitions[std::size_t(transition.from)*inputs + std::size_t(transition.input)] = transition.to;
     }
 }
 
+template<std::size_t states, std::size_t inputs, class State, class Input> void StateMachine<states, inputs, State, Input>::resetTransitionsInternal() {
+    /* Make input in all states a no-op */
+    for(std::size_t i = 0; i != states; ++i)
+        for(std::size_t j = 0; j != inputs; ++j)
+            _transitions[i*inputs + j] = State(i);
+}
+
 template<std::size_t states, std::size_t inputs, class State, class Input> StateMachine<states, inputs, State, Input>& StateMachine<states, inputs, State, Input>::step(Input input) {
     const State next = at(_current, input);
 
+    /* The listeners are checked again before each signal, as the slots can
+       connect or disconnect */
     if(next != _current) {
-        exitedInternal(_current, std::integral_constant<std::size_t, states>{}, next);
-        steppedInternal(_current, std::integral_constant<std::size_t, states>{}, next);
-        enteredInternal(next, std::integral_constant<std::size_t, states>{}, _current);
+        if(listeners(_current) & ExitedListeners)
+            (this->*Signals::exited[std::size_t(_current)])(next);
+        if(listeners(_current) & SteppedListeners)
+            (this->*Signals::stepped[std::size_t(_current)][std::size_t(next)])();
+        if(listeners(next) & EnteredListeners)
+            (this->*Signals::entered[std::size_t(next)])(_current);
         _current = next;
     }
 
     return *this;
 }
 
+template<std::size_t states, std::size_t inputs, class State, class Input> StateMachine<states, inputs, State, Input>& StateMachine<states, inputs, State, Input>::step(const Containers::ArrayView<const Input> sequence) {
+    /* Connections of thread-safe machines can change at any time */
+    if(isThreadSafe()) {
+        for(const Input input: sequence) step(input);
+        return *this;
+    }
+
+    /* Without any connections nothing can observe the intermediate states
+       and there's no slot that could connect something in the middle of the
+       sequence, so just walk the table */
+    if(!hasSignalConnections()) {
+        State current = _current;
+        if(const TransitionTable* const table = _table) {
+            for(const Input input: sequence)
+                current = (*table)(current, input);
+        } else for(const Input input: sequence)
+            current = _transitions[std::size_t(current)*inputs + std::size_t(input)];
+        _current = current;
+        return *this;
+    }
+
+    /* Otherwise the transitions are walked until one that has listeners.
+       Only slots can change the transitions or the listeners, so these are
+       fetched again after each emitting step(). */
+    const Input* it = sequence.begin();
+    const Input* const end = sequence.end();
+    for(;;) {
+        if(const TransitionTable* const table = _table)
+            it = walkInternal(it, end, [table](State current, Input input) {
+                return (*table)(current, input);
+            });
+        else
+            it = walkInternal(it, end, [this](State current, Input input) {
+                return _transitions[std::size_t(current)*inputs + std::size_t(input)];
+            });
+        if(it == end) break;
+        step(*it++);
+    }
+
+    return *this;
+}
+
+template<std::size_t states, std::size_t inputs, class State, class Input> template<class Lookup> const Input* StateMachine<states, inputs, State, Input>::walkInternal(const Input* it, const Input* const end, Lookup lookup) {
+    State current = _current;
+    for(; it != end; ++it) {
+        const State next = lookup(current, *it);
+        if(next != current && ((_listeners[std::size_t(current)] & (ExitedListeners|SteppedListeners)) || (_listeners[std::size_t(next)] & EnteredListeners)))
+            break;
+        current = next;
+    }
+
+    _current = current;
+    return it;
+}
+
+template<std::size_t states, std::size_t inputs, class State, class Input> std::uint8_t StateMachine<states, inputs, State, Input>::listeners(const State state) const {
+    /* Connections can be changed from other threads at any time */
+    if(isThreadSafe()) return ExitedListeners|SteppedListeners|EnteredListeners;
+
+    return _listeners[std::size_t(state)];
+}
+
+template<std::size_t states, std::size_t inputs, class State, class Input> auto StateMachine<states, inputs, State, Input>::signalListeners() -> const std::vector<SignalListener>& {
+    static const std::vector<SignalListener> signalListeners = []() {
+        std::vector<SignalListener> out;
+        out.reserve(states*(states + 2));
+        for(std::size_t i = 0; i != states; ++i) {
+            #ifndef CORRADE_MSVC2015_COMPATIBILITY
+            out.push_back({Implementation::SignalData(Signals::exited[i]), i, ExitedListeners});
+            out.push_back({Implementation::SignalData(Signals::entered[i]), i, EnteredListeners});
+            for(std::size_t j = 0; j != states; ++j)
+                out.push_back({Implementation::SignalData(Signals::stepped[i][j]), i, SteppedListeners});
+            #else
+            out.push_back({Implementation::SignalData::create<StateMachine, State>(Signals::exited[i]), i, ExitedListeners});
+            out.push_back({Implementation::SignalData::create<StateMachine, State>(Signals::entered[i]), i, EnteredListeners});
+            for(std::size_t j = 0; j != states; ++j)
+                out.push_back({Implementation::SignalData::create<StateMachine>(Signals::stepped[i][j]), i, SteppedListeners});
+            #endif
+        }
+        std::sort(out.begin(), out.end(), [](const SignalListener& a, const SignalListener& b) {
+            return a.signal < b.signal;
+        });
+        return out;
+    }();
+    return signalListeners;
+}
+
+template<std::size_t states, std::size_t inputs, class State, class Input> void StateMachine<states, inputs, State, Input>::connectionObserverInternal(Emitter& emitter, const Implementation::SignalData& signal, const bool connected) {
+    /* The mask isn't used for thread-safe machines */
+    if(emitter.isThreadSafe()) return;
+
+    /* Signals of subclasses don't affect anything */
+    const std::vector<SignalListener>& signalListeners = StateMachine::signalListeners();
+    const auto found = std::lower_bound(signalListeners.begin(), signalListeners.end(), signal, [](const SignalListener& a, const Implementation::SignalData& b) {
+        return a.signal < b;
+    });
+    if(found == signalListeners.end() || found->signal != signal) return;
+
+    std::uint8_t& listeners = static_cast<StateMachine&>(emitter)._listeners[found->state];
+    if(connected) {
+        listeners |= found->listener;
+        return;
+    }
+
+    /* The stepped bit is shared by all signals going from given state, so
+       it's cleared only if none of them has connections anymore */
+    if(found->listener == SteppedListeners) for(std::size_t j = 0; j != states; ++j)
+        if(emitter.hasSignalConnections(Signals::stepped[found->state][j])) return;
+    listeners &= ~found->listener;
+}
+
 }}
 
 #endif
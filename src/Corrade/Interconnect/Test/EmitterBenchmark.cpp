@@ -0,0 +1,573 @@
+/*
+    This file is part of Corrade.
+
+    Copyright © 2007, 2008, 2009, 2010, 2011, 2012, 2013, 2014, 2015
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <chrono>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Corrade/TestSuite/Tester.h"
+#include "Corrade/Interconnect/Emitter.h"
+#include "Corrade/Interconnect/Receiver.h"
+#include "Corrade/Interconnect/StateMachine.h"
+
+namespace Corrade { namespace Interconnect { namespace Test {
+
+struct EmitterBenchmark: TestSuite::Tester {
+    explicit EmitterBenchmark();
+
+    void emit0();
+    void emit1();
+    void emit8();
+    void emit1000();
+    void emitIndexed();
+    void emitMemberSlots();
+
+    void emitDisconnectInSlot1k();
+    void emitDisconnectInSlot10k();
+
+    void destroyReceivers1k();
+    void destroyReceivers10k();
+    void destroyReceivers100k();
+    void destroyReceiversMultipleEmitters();
+    void destroyEmitter100k();
+
+    void connectDisconnectFunction();
+    void connectDisconnectMember();
+
+    void stateMachineStep();
+    void stateMachineStepSequence();
+
+    private:
+        std::tuple<std::size_t, std::size_t, std::size_t> emit(std::size_t slotCount);
+        std::pair<std::size_t, std::size_t> emitDisconnectInSlot(std::size_t slotCount);
+        std::size_t destroyReceivers(std::size_t receiverCount);
+};
+
+namespace {
+
+/* Total count of slot calls (or other iterations) in each benchmark, the emit
+   count is derived from it so all cases take roughly the same time */
+enum: std::size_t { SlotCallCount = 1000000 };
+
+class Postman: public Interconnect::Emitter {
+    public:
+        Signal newMessage(int price) {
+            return emit(&Postman::newMessage, price);
+        }
+
+        Signal paymentRequested(int amount) {
+            return emit(&Postman::paymentRequested, amount);
+        }
+
+        Signal parcelDelivered(int weight) {
+            return emit(&Postman::parcelDelivered, weight);
+        }
+
+        Signal parcelLost(int weight) {
+            return emit(&Postman::parcelLost, weight);
+        }
+};
+
+std::size_t counter;
+
+void slot(int value) { counter += std::size_t(value); }
+
+class Mailbox: public Interconnect::Receiver {
+    public:
+        void addMessage(int price) { counter += std::size_t(price); }
+};
+
+/* Replica of the original connection storage with hashed multimap and one heap
+   allocation per connection, to have something to compare to */
+class MultimapPostman {
+    public:
+        explicit MultimapPostman(): lastHandledSignal(0) {}
+
+        ~MultimapPostman() {
+            for(auto& connection: connections) delete connection.second;
+        }
+
+        void connect(const Implementation::SignalData& signal, void(*slot)(int), bool disconnectInSlot = false) {
+            connections.insert(std::make_pair(signal, new Slot{slot, 0, disconnectInSlot}));
+        }
+
+        std::size_t signalConnectionCount() const { return connections.size(); }
+
+        /* Restarts from the beginning every time connections are changed
+           in a slot, as the original implementation did */
+        void emit(const Implementation::SignalData& signal, int value) {
+            ++lastHandledSignal;
+            auto range = connections.equal_range(signal);
+            auto it = range.first;
+            while(it != range.second) {
+                if(it->second->lastHandledSignal != lastHandledSignal) {
+                    it->second->lastHandledSignal = lastHandledSignal;
+                    it->second->slot(value);
+
+                    if(it->second->disconnectInSlot) {
+                        delete it->second;
+                        connections.erase(it);
+                        range = connections.equal_range(signal);
+                        it = range.first;
+                        continue;
+                    }
+                }
+
+                ++it;
+            }
+        }
+
+    private:
+        struct Slot {
+            void(*slot)(int);
+            std::uint32_t lastHandledSignal;
+            bool disconnectInSlot;
+        };
+
+        std::unordered_multimap<Implementation::SignalData, Slot*, Implementation::SignalDataHash> connections;
+        std::uint32_t lastHandledSignal;
+};
+
+template<class F> double nanosecondsPerIteration(std::size_t iterations, F f) {
+    const auto begin = std::chrono::high_resolution_clock::now();
+    for(std::size_t i = 0; i != iterations; ++i) f();
+    return std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - begin).count()/iterations;
+}
+
+/* Many virtual signals and one indexed */
+class VirtualPostman: public Interconnect::Emitter {
+    public:
+        virtual Signal signal0(int value) { return emit(&VirtualPostman::signal0, value); }
+        virtual Signal signal1(int value) { return emit(&VirtualPostman::signal1, value); }
+        virtual Signal signal2(int value) { return emit(&VirtualPostman::signal2, value); }
+        virtual Signal signal3(int value) { return emit(&VirtualPostman::signal3, value); }
+        virtual Signal signal4(int value) { return emit(&VirtualPostman::signal4, value); }
+        virtual Signal signal5(int value) { return emit(&VirtualPostman::signal5, value); }
+        virtual Signal signal6(int value) { return emit(&VirtualPostman::signal6, value); }
+        virtual Signal signal7(int value) { return emit(&VirtualPostman::signal7, value); }
+        virtual Signal signal8(int value) { return emit(&VirtualPostman::signal8, value); }
+        virtual Signal signal9(int value) { return emit(&VirtualPostman::signal9, value); }
+        virtual Signal signal10(int value) { return emit(&VirtualPostman::signal10, value); }
+        virtual Signal signal11(int value) { return emit(&VirtualPostman::signal11, value); }
+        virtual Signal signal12(int value) { return emit(&VirtualPostman::signal12, value); }
+        virtual Signal signal13(int value) { return emit(&VirtualPostman::signal13, value); }
+        virtual Signal signal14(int value) { return emit(&VirtualPostman::signal14, value); }
+        virtual Signal signal15(int value) { return emit(&VirtualPostman::signal15, value); }
+
+        Signal indexed(int value) { return emit<0>(&VirtualPostman::indexed, value); }
+};
+
+enum class State: std::uint8_t {
+    Start,
+    End
+};
+
+enum class Input: std::uint8_t {
+    KeyA,
+    KeyB
+};
+
+inline Utility::Debug& operator<<(Utility::Debug& debug, const State value) {
+    return debug << (value == State::Start ? "State::Start" : "State::End");
+}
+
+typedef Interconnect::StateMachine<2, 2, State, Input> StateMachine;
+
+}
+
+EmitterBenchmark::EmitterBenchmark() {
+    addTests({&EmitterBenchmark::emit0,
+              &EmitterBenchmark::emit1,
+              &EmitterBenchmark::emit8,
+              &EmitterBenchmark::emit1000,
+              &EmitterBenchmark::emitIndexed,
+              &EmitterBenchmark::emitMemberSlots,
+
+              &EmitterBenchmark::emitDisconnectInSlot1k,
+              &EmitterBenchmark::emitDisconnectInSlot10k,
+
+              &EmitterBenchmark::destroyReceivers1k,
+              &EmitterBenchmark::destroyReceivers10k,
+              &EmitterBenchmark::destroyReceivers100k,
+              &EmitterBenchmark::destroyReceiversMultipleEmitters,
+              &EmitterBenchmark::destroyEmitter100k,
+
+              &EmitterBenchmark::connectDisconnectFunction,
+              &EmitterBenchmark::connectDisconnectMember,
+
+              &EmitterBenchmark::stateMachineStep,
+              &EmitterBenchmark::stateMachineStepSequence});
+}
+
+/* Returns count of slot calls done through plain function pointers, the
+   multimap and the emitter */
+std::tuple<std::size_t, std::size_t, std::size_t> EmitterBenchmark::emit(const std::size_t slotCount) {
+    const std::size_t emitCount = slotCount ? SlotCallCount/slotCount : SlotCallCount;
+
+    #ifndef CORRADE_MSVC2015_COMPATIBILITY
+    const Implementation::SignalData newMessage(&Postman::newMessage);
+    const Implementation::SignalData otherSignals[]{
+        Implementation::SignalData(&Postman::paymentRequested),
+        Implementation::SignalData(&Postman::parcelDelivered),
+        Implementation::SignalData(&Postman::parcelLost)};
+    #else
+    const auto newMessage = Implementation::SignalData::create<Postman>(&Postman::newMessage);
+    const Implementation::SignalData otherSignals[]{
+        Implementation::SignalData::create<Postman>(&Postman::paymentRequested),
+        Implementation::SignalData::create<Postman>(&Postman::parcelDelivered),
+        Implementation::SignalData::create<Postman>(&Postman::parcelLost)};
+    #endif
+
+    /* Baseline is calling the function pointers directly */
+    const std::vector<void(*)(int)> functions(slotCount, slot);
+
+    /* Other signals are connected too, so the lookup has some work to do */
+    MultimapPostman multimapPostman;
+    for(const Implementation::SignalData& signal: otherSignals)
+        multimapPostman.connect(signal, slot);
+    for(std::size_t i = 0; i != slotCount; ++i)
+        multimapPostman.connect(newMessage, slot);
+
+    Postman postman;
+    Interconnect::connect(postman, &Postman::paymentRequested, slot);
+    Interconnect::connect(postman, &Postman::parcelDelivered, slot);
+    Interconnect::connect(postman, &Postman::parcelLost, slot);
+    for(std::size_t i = 0; i != slotCount; ++i)
+        Interconnect::connect(postman, &Postman::newMessage, slot);
+
+    counter = 0;
+    const double functionTime = nanosecondsPerIteration(emitCount, [&]() {
+        for(void(*f)(int): functions) f(1);
+    });
+    const std::size_t functionCount = counter;
+
+    counter = 0;
+    const double multimapTime = nanosecondsPerIteration(emitCount, [&]() {
+        multimapPostman.emit(newMessage, 1);
+    });
+    const std::size_t multimapCount = counter;
+
+    counter = 0;
+    const double flatTime = nanosecondsPerIteration(emitCount, [&]() {
+        postman.newMessage(1);
+    });
+
+    Debug() << "   " << slotCount << "slots, function pointers:" << functionTime << "ns, multimap:" << multimapTime << "ns, flat:" << flatTime << "ns per emit";
+    return std::make_tuple(functionCount, multimapCount, counter);
+}
+
+void EmitterBenchmark::emit0() {
+    CORRADE_COMPARE(emit(0), std::make_tuple(std::size_t(0), std::size_t(0), std::size_t(0)));
+}
+
+void EmitterBenchmark::emit1() {
+    CORRADE_COMPARE(emit(1), std::make_tuple(std::size_t(SlotCallCount), std::size_t(SlotCallCount), std::size_t(SlotCallCount)));
+}
+
+void EmitterBenchmark::emit8() {
+    CORRADE_COMPARE(emit(8), std::make_tuple(std::size_t(SlotCallCount), std::size_t(SlotCallCount), std::size_t(SlotCallCount)));
+}
+
+void EmitterBenchmark::emit1000() {
+    CORRADE_COMPARE(emit(1000), std::make_tuple(std::size_t(SlotCallCount), std::size_t(SlotCallCount), std::size_t(SlotCallCount)));
+}
+
+void EmitterBenchmark::emitIndexed() {
+    /* All signals are connected, so the lookup has some work to do */
+    VirtualPostman postman;
+    for(auto signal: {&VirtualPostman::signal0, &VirtualPostman::signal1,
+                      &VirtualPostman::signal2, &VirtualPostman::signal3,
+                      &VirtualPostman::signal4, &VirtualPostman::signal5,
+                      &VirtualPostman::signal6, &VirtualPostman::signal7,
+                      &VirtualPostman::signal8, &VirtualPostman::signal9,
+                      &VirtualPostman::signal10, &VirtualPostman::signal11,
+                      &VirtualPostman::signal12, &VirtualPostman::signal13,
+                      &VirtualPostman::signal14, &VirtualPostman::signal15,
+                      &VirtualPostman::indexed})
+        Interconnect::connect(postman, signal, slot);
+
+    counter = 0;
+    const double lookupTime = nanosecondsPerIteration(SlotCallCount, [&]() {
+        postman.signal7(1);
+    });
+    const std::size_t lookupCount = counter;
+
+    counter = 0;
+    const double indexedTime = nanosecondsPerIteration(SlotCallCount, [&]() {
+        postman.indexed(1);
+    });
+
+    Debug() << "    17 signals, lookup:" << lookupTime << "ns, indexed:" << indexedTime << "ns per emit";
+    CORRADE_COMPARE(std::make_pair(lookupCount, counter), std::make_pair(std::size_t(SlotCallCount), std::size_t(SlotCallCount)));
+}
+
+void EmitterBenchmark::emitMemberSlots() {
+    Postman postman;
+    std::vector<Mailbox> mailboxes(10);
+    for(Mailbox& mailbox: mailboxes)
+        Interconnect::connect(postman, &Postman::newMessage, mailbox, &Mailbox::addMessage);
+
+    counter = 0;
+    const double time = nanosecondsPerIteration(SlotCallCount/10, [&]() {
+        postman.newMessage(1);
+    });
+
+    Debug() << "    10 member slots:" << time/10 << "ns per slot call";
+    CORRADE_COMPARE(counter, std::size_t(SlotCallCount));
+}
+
+/* Every slot disconnects itself when called. Returns count of slot calls
+   done through the multimap and the emitter, with all connections expected
+   to be gone afterwards. */
+std::pair<std::size_t, std::size_t> EmitterBenchmark::emitDisconnectInSlot(const std::size_t slotCount) {
+    #ifndef CORRADE_MSVC2015_COMPATIBILITY
+    const Implementation::SignalData newMessage(&Postman::newMessage);
+    #else
+    const auto newMessage = Implementation::SignalData::create<Postman>(&Postman::newMessage);
+    #endif
+
+    MultimapPostman multimapPostman;
+    for(std::size_t i = 0; i != slotCount; ++i)
+        multimapPostman.connect(newMessage, slot, true);
+
+    Postman postman;
+    std::vector<Connection> connections;
+    connections.reserve(slotCount);
+    for(std::size_t i = 0; i != slotCount; ++i)
+        connections.push_back(Interconnect::connect(postman, &Postman::newMessage, [&connections, i](int value) {
+            counter += std::size_t(value);
+            connections[i].disconnect();
+        }));
+
+    counter = 0;
+    const double multimapTime = nanosecondsPerIteration(1, [&]() {
+        multimapPostman.emit(newMessage, 1);
+    });
+    const std::size_t multimapCount = multimapPostman.signalConnectionCount() ? 0 : counter;
+
+    counter = 0;
+    const double flatTime = nanosecondsPerIteration(1, [&]() {
+        postman.newMessage(1);
+    });
+    const std::size_t flatCount = postman.signalConnectionCount() ? 0 : counter;
+
+    Debug() << "   " << slotCount << "slots, multimap:" << multimapTime/slotCount << "ns, flat:" << flatTime/slotCount << "ns per slot call";
+    return {multimapCount, flatCount};
+}
+
+void EmitterBenchmark::emitDisconnectInSlot1k() {
+    CORRADE_COMPARE(emitDisconnectInSlot(1000), std::make_pair(std::size_t(1000), std::size_t(1000)));
+}
+
+void EmitterBenchmark::emitDisconnectInSlot10k() {
+    CORRADE_COMPARE(emitDisconnectInSlot(10000), std::make_pair(std::size_t(10000), std::size_t(10000)));
+}
+
+/* Returns count of connections remaining after all receivers are destroyed */
+std::size_t EmitterBenchmark::destroyReceivers(const std::size_t receiverCount) {
+    Postman postman;
+    std::vector<Mailbox*> mailboxes(receiverCount);
+    for(Mailbox*& mailbox: mailboxes) {
+        mailbox = new Mailbox;
+        Interconnect::connect(postman, &Postman::newMessage, *mailbox, &Mailbox::addMessage);
+    }
+
+    /* Destroying in reverse order, the worst case for linear search */
+    const auto begin = std::chrono::high_resolution_clock::now();
+    for(auto it = mailboxes.rbegin(); it != mailboxes.rend(); ++it)
+        delete *it;
+    const double time = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - begin).count();
+
+    Debug() << "   " << receiverCount << "receivers:" << time/receiverCount << "ns per receiver";
+    return postman.signalConnectionCount();
+}
+
+void EmitterBenchmark::destroyReceivers1k() {
+    CORRADE_COMPARE(destroyReceivers(1000), 0);
+}
+
+void EmitterBenchmark::destroyReceivers10k() {
+    CORRADE_COMPARE(destroyReceivers(10000), 0);
+}
+
+void EmitterBenchmark::destroyReceivers100k() {
+    CORRADE_COMPARE(destroyReceivers(100000), 0);
+}
+
+void EmitterBenchmark::destroyReceiversMultipleEmitters() {
+    /* Every receiver is connected to ten emitters */
+    std::vector<Postman> postmen(10);
+    std::vector<Mailbox*> mailboxes(SlotCallCount/100);
+    for(Mailbox*& mailbox: mailboxes) {
+        mailbox = new Mailbox;
+        for(Postman& postman: postmen)
+            Interconnect::connect(postman, &Postman::newMessage, *mailbox, &Mailbox::addMessage);
+    }
+
+    std::size_t i = 0;
+    const double time = nanosecondsPerIteration(mailboxes.size(), [&]() {
+        delete mailboxes[i++];
+    });
+
+    Debug() << "   " << mailboxes.size() << "receivers with 10 connections:" << time << "ns per receiver";
+    std::size_t remaining = 0;
+    for(const Postman& postman: postmen) remaining += postman.signalConnectionCount();
+    CORRADE_COMPARE(remaining, 0);
+}
+
+void EmitterBenchmark::destroyEmitter100k() {
+    Mailbox mailbox;
+    std::vector<Postman*> postmen(100000);
+    for(Postman*& postman: postmen) {
+        postman = new Postman;
+        Interconnect::connect(*postman, &Postman::newMessage, mailbox, &Mailbox::addMessage);
+    }
+
+    const auto begin = std::chrono::high_resolution_clock::now();
+    for(Postman* postman: postmen) delete postman;
+    const double time = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - begin).count();
+
+    Debug() << "   " << postmen.size() << "emitters:" << time/postmen.size() << "ns per emitter";
+    CORRADE_VERIFY(!mailbox.hasSlotConnections());
+}
+
+void EmitterBenchmark::connectDisconnectFunction() {
+    Postman postman;
+    std::vector<Connection> connections;
+    connections.reserve(SlotCallCount/10);
+
+    const double connectTime = nanosecondsPerIteration(SlotCallCount/10, [&]() {
+        connections.push_back(Interconnect::connect(postman, &Postman::newMessage, slot));
+    });
+    const std::size_t connectionCount = postman.signalConnectionCount();
+
+    std::size_t i = 0;
+    const double disconnectTime = nanosecondsPerIteration(SlotCallCount/10, [&]() {
+        connections[i++].disconnect();
+    });
+
+    Debug() << "   " << connectionCount << "function slots:" << connectTime << "ns per connect," << disconnectTime << "ns per disconnect";
+    CORRADE_COMPARE(std::make_pair(connectionCount, postman.signalConnectionCount()), std::make_pair(std::size_t(SlotCallCount/10), std::size_t(0)));
+}
+
+void EmitterBenchmark::connectDisconnectMember() {
+    Postman postman;
+    Mailbox mailbox;
+    std::vector<Connection> connections;
+    connections.reserve(SlotCallCount/10);
+
+    const double connectTime = nanosecondsPerIteration(SlotCallCount/10, [&]() {
+        connections.push_back(Interconnect::connect(postman, &Postman::newMessage, mailbox, &Mailbox::addMessage));
+    });
+    const std::size_t connectionCount = mailbox.slotConnectionCount();
+
+    std::size_t i = 0;
+    const double disconnectTime = nanosecondsPerIteration(SlotCallCount/10, [&]() {
+        connections[i++].disconnect();
+    });
+
+    Debug() << "   " << connectionCount << "member slots:" << connectTime << "ns per connect," << disconnectTime << "ns per disconnect";
+    CORRADE_COMPARE(std::make_pair(connectionCount, mailbox.slotConnectionCount()), std::make_pair(std::size_t(SlotCallCount/10), std::size_t(0)));
+}
+
+void EmitterBenchmark::stateMachineStep() {
+    /* Baseline is a transition table with function pointers called on state
+       change */
+    const State table[2][2]{{State::End, State::Start}, {State::End, State::Start}};
+    void(*const entered[2])(int){slot, slot};
+    State current = State::Start;
+
+    StateMachine machine;
+    machine.addTransitions({
+        {State::Start, Input::KeyA, State::End},
+        {State::End, Input::KeyB, State::Start}
+    });
+    Interconnect::connect(machine, &StateMachine::entered<State::Start>, [](State) { ++counter; });
+    Interconnect::connect(machine, &StateMachine::entered<State::End>, [](State) { ++counter; });
+
+    /* Every second step is a no-op */
+    const Input inputs[]{Input::KeyA, Input::KeyA, Input::KeyB, Input::KeyB};
+
+    counter = 0;
+    std::size_t i = 0;
+    const double baselineTime = nanosecondsPerIteration(SlotCallCount, [&]() {
+        const State next = table[std::size_t(current)][std::size_t(inputs[i++ % 4])];
+        if(next != current) {
+            current = next;
+            entered[std::size_t(next)](1);
+        }
+    });
+    const std::size_t baselineCount = counter;
+
+    counter = 0;
+    i = 0;
+    const double stepTime = nanosecondsPerIteration(SlotCallCount, [&]() {
+        machine.step(inputs[i++ % 4]);
+    });
+
+    Debug() << "    2 states, function pointers:" << baselineTime << "ns, StateMachine:" << stepTime << "ns per step";
+    CORRADE_COMPARE(std::make_pair(baselineCount, counter), std::make_pair(std::size_t(SlotCallCount/2), std::size_t(SlotCallCount/2)));
+}
+
+void EmitterBenchmark::stateMachineStepSequence() {
+    StateMachine machine;
+    machine.addTransitions({
+        {State::Start, Input::KeyA, State::End},
+        {State::End, Input::KeyB, State::Start}
+    });
+
+    std::vector<Input> inputs(1000);
+    for(std::size_t i = 0; i != inputs.size(); ++i)
+        inputs[i] = i % 3 ? Input::KeyA : Input::KeyB;
+    const Containers::ArrayView<const Input> sequence{inputs.data(), inputs.size()};
+
+    /* No connections first, then only the rare transition to the start
+       state is observed */
+    for(const bool connected: {false, true}) {
+        if(connected) Interconnect::connect(machine, &StateMachine::entered<State::Start>, [](State) { ++counter; });
+
+        counter = 0;
+        const double stepTime = nanosecondsPerIteration(SlotCallCount/1000, [&]() {
+            for(const Input input: sequence) machine.step(input);
+        });
+        const State stepState = machine.current();
+        const std::size_t stepCount = counter;
+
+        counter = 0;
+        const double sequenceTime = nanosecondsPerIteration(SlotCallCount/1000, [&]() {
+            machine.step(sequence);
+        });
+
+        Debug() << "    1000 inputs," << (connected ? "one connection," : "no connections,") << "step():" << stepTime/1000 << "ns, step(sequence):" << sequenceTime/1000 << "ns per input";
+        CORRADE_COMPARE(machine.current(), stepState);
+        CORRADE_COMPARE(counter, stepCount);
+    }
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Corrade::Interconnect::Test::EmitterBenchmark)
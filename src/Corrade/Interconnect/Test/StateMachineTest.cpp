@@ -35,11 +35,31 @@ struct StateMachineTest: TestSuite::Tester {
 
     void signalData();
     void test();
+    void stepSequence();
+    void stepSequenceNoConnections();
+    void stepSequenceConnectInSlot();
+    void connectionsChanged();
+    void transitionTable();
+    void transitionTableHierarchical();
+    void transitionTableAddTransitions();
+    void transitionTableMany();
+    void transitionTableTemporary();
+    void move();
 };
 
 StateMachineTest::StateMachineTest() {
     addTests({&StateMachineTest::signalData,
-              &StateMachineTest::test});
+              &StateMachineTest::test,
+              &StateMachineTest::stepSequence,
+              &StateMachineTest::stepSequenceNoConnections,
+              &StateMachineTest::stepSequenceConnectInSlot,
+              &StateMachineTest::connectionsChanged,
+              &StateMachineTest::transitionTable,
+              &StateMachineTest::transitionTableHierarchical,
+              &StateMachineTest::transitionTableAddTransitions,
+              &StateMachineTest::transitionTableMany,
+              &StateMachineTest::transitionTableTemporary,
+              &StateMachineTest::move});
 }
 
 enum class State: std::uint8_t {
@@ -52,8 +72,86 @@ enum class Input: std::uint8_t {
     KeyB
 };
 
+inline Utility::Debug& operator<<(Utility::Debug& debug, const State value) {
+    return debug << (value == State::Start ? "State::Start" : "State::End");
+}
+
 typedef Interconnect::StateMachine<2, 2, State, Input> StateMachine;
 
+constexpr StateTransition<State, Input> Transitions[]{
+    {State::Start,  Input::KeyA,    State::End},
+    {State::End,    Input::KeyB,    State::Start}
+};
+constexpr StateTransitionTable<2, 2, State, Input> Table{Transitions};
+
+enum class PrinterState: std::uint8_t {
+    Ready,
+    Busy,
+    Printing,
+    Finished
+};
+
+enum class PrinterInput: std::uint8_t {
+    Operate,
+    Cancel,
+    Remove
+};
+
+constexpr StateParent<PrinterState> PrinterParents[]{
+    {PrinterState::Printing, PrinterState::Busy},
+    {PrinterState::Finished, PrinterState::Busy}
+};
+
+constexpr StateTransition<PrinterState, PrinterInput> PrinterTransitions[]{
+    {PrinterState::Ready,       PrinterInput::Operate,  PrinterState::Printing},
+    {PrinterState::Printing,    PrinterInput::Operate,  PrinterState::Finished},
+    {PrinterState::Busy,        PrinterInput::Cancel,   PrinterState::Ready},
+    {PrinterState::Busy,        PrinterInput::Remove,   PrinterState::Ready},
+    /* Overrides the parent transition */
+    {PrinterState::Printing,    PrinterInput::Remove,   PrinterState::Printing}
+};
+
+constexpr StateTransitionTable<4, 3, PrinterState, PrinterInput> PrinterTable{PrinterTransitions, PrinterParents};
+
+/* A table with more transitions than compilers allow constexpr recursion
+   levels. Utility::Implementation::GenerateSequence is itself linearly
+   recursive, so the index sequence is generated by halving. */
+enum class ManyState: std::uint8_t {};
+enum class ManyInput: std::uint8_t {};
+
+enum: std::size_t {
+    ManyStateCount = 16,
+    ManyInputCount = 4,
+    ManyTransitionCount = 1200
+};
+
+template<class, class> struct ConcatSequence;
+template<std::size_t ...a, std::size_t ...b> struct ConcatSequence<Utility::Implementation::Sequence<a...>, Utility::Implementation::Sequence<b...>> {
+    typedef Utility::Implementation::Sequence<a..., (sizeof...(a) + b)...> Type;
+};
+
+template<std::size_t n> struct HalvingSequence: ConcatSequence<typename HalvingSequence<n/2>::Type, typename HalvingSequence<n - n/2>::Type> {};
+template<> struct HalvingSequence<0> { typedef Utility::Implementation::Sequence<> Type; };
+template<> struct HalvingSequence<1> { typedef Utility::Implementation::Sequence<0> Type; };
+
+/* Every state is listed many times with all inputs except the last, the last
+   of them has to win. The last input isn't listed at all, so the whole list
+   is searched for it. */
+constexpr StateTransition<ManyState, ManyInput> manyTransition(std::size_t i) {
+    return {ManyState(i%ManyStateCount), ManyInput(i/ManyStateCount%(ManyInputCount - 1)), ManyState((i*7 + 3)%ManyStateCount)};
+}
+
+struct ManyTransitionArray {
+    StateTransition<ManyState, ManyInput> data[ManyTransitionCount];
+};
+
+template<std::size_t ...i> constexpr ManyTransitionArray manyTransitions(Utility::Implementation::Sequence<i...>) {
+    return {{manyTransition(i)...}};
+}
+
+constexpr ManyTransitionArray ManyTransitions = manyTransitions(HalvingSequence<ManyTransitionCount>::Type{});
+constexpr StateTransitionTable<ManyStateCount, ManyInputCount, ManyState, ManyInput> ManyTable{ManyTransitions.data};
+
 void StateMachineTest::signalData() {
     #ifndef CORRADE_MSVC2015_COMPATIBILITY
     Implementation::SignalData data1{&StateMachine::entered<State::Start>};
@@ -111,6 +209,262 @@ void StateMachineTest::test() {
                                "start entered, previous 1\n");
 }
 
+void StateMachineTest::stepSequence() {
+    StateMachine m;
+    m.addTransitions({
+        {State::Start,  Input::KeyA,    State::End},
+        {State::End,    Input::KeyB,    State::Start}
+    });
+
+    std::ostringstream out;
+    Debug::setOutput(&out);
+
+    Interconnect::connect(m, &StateMachine::entered<State::Start>,
+        [](State s) { Debug() << "start entered, previous" << std::uint8_t(s); });
+    Interconnect::connect(m, &StateMachine::entered<State::End>,
+        [](State s) { Debug() << "end entered, previous" << std::uint8_t(s); });
+
+    /* The second KeyA and the first KeyB are no-ops */
+    const Input sequence[]{Input::KeyA, Input::KeyA, Input::KeyB, Input::KeyB};
+    m.step(sequence);
+    CORRADE_COMPARE(m.current(), State::Start);
+    CORRADE_COMPARE(out.str(), "end entered, previous 0\n"
+                               "start entered, previous 1\n");
+}
+
+void StateMachineTest::stepSequenceNoConnections() {
+    StateMachine m;
+    m.addTransitions({
+        {State::Start,  Input::KeyA,    State::End},
+        {State::End,    Input::KeyB,    State::Start}
+    });
+
+    const Input sequence[]{Input::KeyA, Input::KeyB, Input::KeyA};
+    m.step(sequence);
+    CORRADE_COMPARE(m.current(), State::End);
+
+    m.step(nullptr);
+    CORRADE_COMPARE(m.current(), State::End);
+}
+
+void StateMachineTest::stepSequenceConnectInSlot() {
+    StateMachine m;
+    m.addTransitions({
+        {State::Start,  Input::KeyA,    State::End},
+        {State::End,    Input::KeyB,    State::Start}
+    });
+
+    std::ostringstream out;
+    Debug::setOutput(&out);
+
+    /* Only entering the end state is observed at first, the transitions to
+       start state are skipped until the slot connects to it */
+    int entered = 0;
+    Interconnect::connect(m, &StateMachine::entered<State::End>, [&m, &entered](State) {
+        Debug() << "end entered";
+        if(++entered == 2) Interconnect::connect(m, &StateMachine::entered<State::Start>,
+            [](State) { Debug() << "start entered"; });
+    });
+
+    const Input sequence[]{Input::KeyA, Input::KeyB, Input::KeyA, Input::KeyA, Input::KeyB, Input::KeyA};
+    m.step(sequence);
+    CORRADE_COMPARE(m.current(), State::End);
+    CORRADE_COMPARE(out.str(), "end entered\n"
+                               "end entered\n"
+                               "start entered\n"
+                               "end entered\n");
+}
+
+void StateMachineTest::connectionsChanged() {
+    StateMachine m;
+    m.addTransitions({
+        {State::Start,  Input::KeyA,    State::End},
+        {State::End,    Input::KeyB,    State::Start}
+    });
+
+    std::ostringstream out;
+    Debug::setOutput(&out);
+
+    /* Nothing connected yet */
+    m.step(Input::KeyA);
+    CORRADE_COMPARE(out.str(), "");
+
+    /* Connecting after some steps were done gets picked up */
+    Connection entered = Interconnect::connect(m, &StateMachine::entered<State::End>,
+        [](State) { Debug() << "end entered"; });
+    Interconnect::connect(m, &StateMachine::stepped<State::End, State::Start>,
+        []() { Debug() << "going from end to start"; });
+    m.step(Input::KeyB)
+     .step(Input::KeyA);
+    CORRADE_COMPARE(out.str(), "going from end to start\n"
+                               "end entered\n");
+
+    /* Disconnecting in a slot is picked up by the same step */
+    out.str({});
+    Interconnect::connect(m, &StateMachine::exited<State::Start>,
+        [&entered](State) {
+            Debug() << "start exited";
+            entered.disconnect();
+        });
+    m.step(Input::KeyB)
+     .step(Input::KeyA);
+    CORRADE_COMPARE(out.str(), "going from end to start\n"
+                               "start exited\n");
+
+    /* Signals for going from the same state share the listener bit, which
+       is kept while any of them has connections */
+    out.str({});
+    Connection stepped = Interconnect::connect(m, &StateMachine::stepped<State::End, State::End>,
+        []() { Debug() << "going from end to end"; });
+    stepped.disconnect();
+    m.step(Input::KeyB);
+    CORRADE_COMPARE(out.str(), "going from end to start\n");
+
+    /* Disconnecting whole signals is picked up as well */
+    out.str({});
+    m.disconnectSignal(&StateMachine::stepped<State::End, State::Start>);
+    m.step(Input::KeyA)
+     .step(Input::KeyB);
+    CORRADE_COMPARE(out.str(), "start exited\n");
+
+    out.str({});
+    m.disconnectAllSignals();
+    m.step(Input::KeyA)
+     .step(Input::KeyB);
+    CORRADE_COMPARE(out.str(), "");
+}
+
+void StateMachineTest::transitionTable() {
+    /* Verify that the table is really usable at compile time */
+    constexpr State next = Table(State::Start, Input::KeyA);
+    constexpr State same = Table(State::Start, Input::KeyB);
+    CORRADE_COMPARE(next, State::End);
+    CORRADE_COMPARE(same, State::Start);
+
+    StateMachine a{Table}, b{Table};
+
+    std::ostringstream out;
+    Debug::setOutput(&out);
+
+    Interconnect::connect(a, &StateMachine::entered<State::End>,
+        [](State) { Debug() << "a entered end"; });
+    Interconnect::connect(b, &StateMachine::entered<State::Start>,
+        [](State) { Debug() << "b entered start"; });
+
+    a.step(Input::KeyA);
+    b.step(Input::KeyA)
+     .step(Input::KeyB);
+    CORRADE_COMPARE(a.current(), State::End);
+    CORRADE_COMPARE(b.current(), State::Start);
+    CORRADE_COMPARE(out.str(), "a entered end\n"
+                               "b entered start\n");
+}
+
+void StateMachineTest::transitionTableHierarchical() {
+    /* Own transitions */
+    CORRADE_VERIFY(PrinterTable(PrinterState::Ready, PrinterInput::Operate) == PrinterState::Printing);
+    CORRADE_VERIFY(PrinterTable(PrinterState::Printing, PrinterInput::Operate) == PrinterState::Finished);
+
+    /* Inherited from parent */
+    CORRADE_VERIFY(PrinterTable(PrinterState::Printing, PrinterInput::Cancel) == PrinterState::Ready);
+    CORRADE_VERIFY(PrinterTable(PrinterState::Finished, PrinterInput::Cancel) == PrinterState::Ready);
+    CORRADE_VERIFY(PrinterTable(PrinterState::Finished, PrinterInput::Remove) == PrinterState::Ready);
+
+    /* Overridden parent transition */
+    CORRADE_VERIFY(PrinterTable(PrinterState::Printing, PrinterInput::Remove) == PrinterState::Printing);
+
+    /* No transition in the state nor the parent, no-op */
+    CORRADE_VERIFY(PrinterTable(PrinterState::Finished, PrinterInput::Operate) == PrinterState::Finished);
+    CORRADE_VERIFY(PrinterTable(PrinterState::Ready, PrinterInput::Cancel) == PrinterState::Ready);
+
+    Interconnect::StateMachine<4, 3, PrinterState, PrinterInput> m{PrinterTable};
+    const PrinterInput sequence[]{PrinterInput::Operate, PrinterInput::Remove, PrinterInput::Operate, PrinterInput::Remove};
+    m.step(sequence);
+    CORRADE_VERIFY(m.current() == PrinterState::Ready);
+}
+
+void StateMachineTest::transitionTableAddTransitions() {
+    StateMachine a{Table}, b{Table};
+
+    /* Modifies only a copy of the table in a */
+    a.addTransitions({{State::Start, Input::KeyB, State::End}});
+
+    a.step(Input::KeyB);
+    b.step(Input::KeyB);
+    CORRADE_COMPARE(a.current(), State::End);
+    CORRADE_COMPARE(b.current(), State::Start);
+    CORRADE_COMPARE(Table(State::Start, Input::KeyB), State::Start);
+
+    /* Original transitions are kept */
+    a.step(Input::KeyB);
+    CORRADE_COMPARE(a.current(), State::Start);
+}
+
+void StateMachineTest::transitionTableMany() {
+    /* Verify that the table is really usable at compile time */
+    constexpr ManyState last = ManyTable(ManyState(15), ManyInput(2));
+    constexpr ManyState same = ManyTable(ManyState(15), ManyInput(3));
+    CORRADE_COMPARE(std::size_t(last), (1199*7 + 3)%ManyStateCount);
+    CORRADE_COMPARE(std::size_t(same), 15);
+
+    ManyState expected[ManyStateCount][ManyInputCount];
+    for(std::size_t i = 0; i != ManyStateCount; ++i)
+        expected[i][ManyInputCount - 1] = ManyState(i);
+    for(std::size_t i = 0; i != ManyTransitionCount; ++i)
+        expected[i%ManyStateCount][i/ManyStateCount%(ManyInputCount - 1)] = ManyState((i*7 + 3)%ManyStateCount);
+
+    for(std::size_t i = 0; i != ManyStateCount; ++i)
+        for(std::size_t j = 0; j != ManyInputCount; ++j)
+            CORRADE_COMPARE(std::size_t(ManyTable(ManyState(i), ManyInput(j))), std::size_t(expected[i][j]));
+}
+
+void StateMachineTest::transitionTableTemporary() {
+    /* The machine would reference a destroyed table */
+    CORRADE_VERIFY((std::is_constructible<StateMachine, const StateTransitionTable<2, 2, State, Input>&>::value));
+    CORRADE_VERIFY(!(std::is_constructible<StateMachine, StateTransitionTable<2, 2, State, Input>>::value));
+}
+
+void StateMachineTest::move() {
+    StateMachine a;
+    a.addTransitions({
+        {State::Start,  Input::KeyA,    State::End},
+        {State::End,    Input::KeyB,    State::Start}
+    });
+
+    std::ostringstream out;
+    Debug::setOutput(&out);
+
+    Interconnect::connect(a, &StateMachine::entered<State::End>,
+        [](State) { Debug() << "end entered"; });
+    a.step(Input::KeyA)
+     .step(Input::KeyB);
+
+    StateMachine b{std::move(a)};
+    CORRADE_COMPARE(b.current(), State::Start);
+    b.step(Input::KeyA);
+    CORRADE_COMPARE(out.str(), "end entered\n"
+                               "end entered\n");
+
+    /* The moved-from machine has no transitions and connections anymore */
+    a.step(Input::KeyA);
+    CORRADE_COMPARE(a.current(), State::Start);
+    CORRADE_COMPARE(out.str(), "end entered\n"
+                               "end entered\n");
+
+    /* Move assignment swaps everything */
+    StateMachine c{Table};
+    Interconnect::connect(c, &StateMachine::entered<State::Start>,
+        [](State) { Debug() << "start entered"; });
+    out.str({});
+    c = std::move(b);
+    c.step(Input::KeyB);
+    b.step(Input::KeyA)
+     .step(Input::KeyB);
+    CORRADE_COMPARE(c.current(), State::Start);
+    CORRADE_COMPARE(b.current(), State::Start);
+    CORRADE_COMPARE(out.str(), "start entered\n");
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Corrade::Interconnect::Test::StateMachineTest)
@@ -23,12 +23,18 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <atomic>
+#include <memory>
 #include <sstream>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
 
 #include "Corrade/TestSuite/Tester.h"
 #include "Corrade/TestSuite/Compare/Container.h"
 #include "Corrade/Interconnect/Emitter.h"
 #include "Corrade/Interconnect/Receiver.h"
+#include "Corrade/Interconnect/SignalWaiter.h"
 
 namespace Corrade { namespace Interconnect { namespace Test {
 
@@ -47,6 +53,16 @@ struct Test: TestSuite::Tester {
 
     void destroyEmitter();
     void destroyReceiver();
+    void destroyReceiverInterleaved();
+
+    void moveEmitter();
+    void moveEmitterAssign();
+    void moveEmitterDeferred();
+    void moveEmitterThreadSafe();
+    void moveReceiver();
+    void moveReceiverAssign();
+    void moveReceiverQueued();
+    void moveInVector();
 
     void emit();
     void emitterSubclass();
@@ -54,11 +70,53 @@ struct Test: TestSuite::Tester {
     void slotInReceiverBase();
     void virtualSlot();
     void templatedSignal();
+    void indexedSignal();
+    void indexedSignalDuplicateIndex();
+    void deferredSignal();
+    void deferredSignalInSlot();
+    void deferredSignalDestroyEmitter();
+    void signalProfile();
+    void signalProfileThreadSafe();
+    void signalWaiter();
+    void signalWaiterAwait();
+    void signalWaiterDestroy();
+    void signalWaiterDestroyEmitter();
+    void forwardSignal();
+    void forwardSignalCycle();
+    void forwardSignalDestroyTarget();
+    void forwardSignalMoveTarget();
+    void forwardSignalThreadSafe();
 
     void changeConnectionsInSlot();
+    void disconnectInSlot();
+    void disconnectOtherSignalInSlot();
+    void disconnectSignalInSlot();
     void deleteReceiverInSlot();
 
     void function();
+    void functor();
+    void functorHeap();
+    void functorDestruction();
+
+    void priority();
+    void priorityDisconnected();
+    void priorityInSlot();
+    void consumed();
+    void consumedThreadSafe();
+
+    void connectionDataPool();
+    void connectionDataPoolThreadExit();
+    void connectionDataPoolStaticEmitter();
+
+    void threadSafe();
+    void threadSafeConcurrentEmit();
+
+    void queued();
+    void queuedDisconnect();
+    void queuedDisconnectReconnect();
+    void queuedDestroyReceiver();
+    void queuedDeleteReceiverInSlot();
+    void queuedThreadSafe();
 };
 
 class Postman: public Interconnect::Emitter {
@@ -72,6 +130,51 @@ class Postman: public Interconnect::Emitter {
         }
 };
 
+class ThreadSafePostman: public Interconnect::Emitter {
+    public:
+        explicit ThreadSafePostman(): Interconnect::Emitter{Interconnect::ThreadSafe} {}
+
+        Signal newMessage(int price, const std::string& message) {
+            return emit(&ThreadSafePostman::newMessage, price, message);
+        }
+
+        Signal paymentRequested(int amount) {
+            return emit(&ThreadSafePostman::paymentRequested, amount);
+        }
+};
+
+class IndexedPostman: public Interconnect::Emitter {
+    public:
+        Signal newMessage(int price, const std::string& message) {
+            return emit<0>(&IndexedPostman::newMessage, price, message);
+        }
+
+        Signal paymentRequested(int amount) {
+            return emit<3>(&IndexedPostman::paymentRequested, amount);
+        }
+
+        /* Not indexed */
+        Signal paymentCancelled(int amount) {
+            return emit(&IndexedPostman::paymentCancelled, amount);
+        }
+
+        /* Wrongly using the same index as newMessage() */
+        Signal parcelDelivered(int weight) {
+            return emit<0>(&IndexedPostman::parcelDelivered, weight);
+        }
+};
+
+class DeferredPostman: public Interconnect::Emitter {
+    public:
+        Signal newMessage(int price, const std::string& message) {
+            return emitDeferred(&DeferredPostman::newMessage, price, message);
+        }
+
+        Signal paymentRequested(int amount) {
+            return emitDeferred(&DeferredPostman::paymentRequested, amount);
+        }
+};
+
 class TemplatedPostman: public Interconnect::Emitter {
     public:
         template<class T> Signal newMessage(int price, const std::string& message) {
@@ -130,6 +233,16 @@ Test::Test() {
 
               &Test::destroyEmitter,
               &Test::destroyReceiver,
+              &Test::destroyReceiverInterleaved,
+
+              &Test::moveEmitter,
+              &Test::moveEmitterAssign,
+              &Test::moveEmitterDeferred,
+              &Test::moveEmitterThreadSafe,
+              &Test::moveReceiver,
+              &Test::moveReceiverAssign,
+              &Test::moveReceiverQueued,
+              &Test::moveInVector,
 
               &Test::emit,
               &Test::emitterSubclass,
@@ -137,11 +250,53 @@ Test::Test() {
               &Test::slotInReceiverBase,
               &Test::virtualSlot,
               &Test::templatedSignal,
+              &Test::indexedSignal,
+              &Test::indexedSignalDuplicateIndex,
+              &Test::deferredSignal,
+              &Test::deferredSignalInSlot,
+              &Test::deferredSignalDestroyEmitter,
+              &Test::signalProfile,
+              &Test::signalProfileThreadSafe,
+              &Test::signalWaiter,
+              &Test::signalWaiterAwait,
+              &Test::signalWaiterDestroy,
+              &Test::signalWaiterDestroyEmitter,
+              &Test::forwardSignal,
+              &Test::forwardSignalCycle,
+              &Test::forwardSignalDestroyTarget,
+              &Test::forwardSignalMoveTarget,
+              &Test::forwardSignalThreadSafe,
 
               &Test::changeConnectionsInSlot,
+              &Test::disconnectInSlot,
+              &Test::disconnectOtherSignalInSlot,
+              &Test::disconnectSignalInSlot,
               &Test::deleteReceiverInSlot,
 
-              &Test::function});
+              &Test::function,
+              &Test::functor,
+              &Test::functorHeap,
+              &Test::functorDestruction,
+
+              &Test::priority,
+              &Test::priorityDisconnected,
+              &Test::priorityInSlot,
+              &Test::consumed,
+              &Test::consumedThreadSafe,
+
+              &Test::connectionDataPool,
+              &Test::connectionDataPoolThreadExit,
+              &Test::connectionDataPoolStaticEmitter,
+
+              &Test::threadSafe,
+              &Test::threadSafeConcurrentEmit,
+
+              &Test::queued,
+              &Test::queuedDisconnect,
+              &Test::queuedDisconnectReconnect,
+              &Test::queuedDestroyReceiver,
+              &Test::queuedDeleteReceiverInSlot,
+              &Test::queuedThreadSafe});
 }
 
 void Test::signalData() {
@@ -165,6 +320,10 @@ void Test::signalData() {
     CORRADE_VERIFY(Implementation::SignalDataHash()(data1) == Implementation::SignalDataHash()(data1));
     CORRADE_VERIFY(Implementation::SignalDataHash()(data1) == Implementation::SignalDataHash()(data2));
     CORRADE_VERIFY(Implementation::SignalDataHash()(data1) != Implementation::SignalDataHash()(data3));
+
+    CORRADE_VERIFY(!(data1 < data2));
+    CORRADE_VERIFY(!(data2 < data1));
+    CORRADE_VERIFY((data1 < data3) != (data3 < data1));
 }
 
 void Test::templatedSignalData()
@@ -332,6 +491,248 @@ void Test::destroyReceiver() {
     CORRADE_COMPARE(mailbox2.slotConnectionCount(), 1);
 }
 
+void Test::destroyReceiverInterleaved() {
+    Postman postman;
+    Mailbox* mailboxes[10];
+    for(Mailbox*& mailbox: mailboxes) {
+        mailbox = new Mailbox;
+        Interconnect::connect(postman, &Postman::newMessage, *mailbox, &Mailbox::addMessage);
+    }
+    Mailbox mailbox;
+    Connection c1 = Interconnect::connect(postman, &Postman::newMessage, mailbox, &Mailbox::addMessage);
+    Connection c2 = Interconnect::connect(postman, &Postman::paymentRequested, *mailboxes[9], &Mailbox::pay);
+    Connection c3 = Interconnect::connect(postman, &Postman::paymentRequested, *mailboxes[1], &Mailbox::pay);
+    CORRADE_COMPARE(postman.signalConnectionCount(), 13);
+    CORRADE_COMPARE(mailboxes[9]->slotConnectionCount(), 2);
+
+    /* Removing more than half of the connections compacts the slot array,
+       which shouldn't affect anything */
+    for(std::size_t i: {0, 2, 4, 6, 8, 3}) {
+        delete mailboxes[i];
+        mailboxes[i] = nullptr;
+    }
+    CORRADE_COMPARE(postman.signalConnectionCount(), 7);
+    CORRADE_COMPARE(postman.signalConnectionCount(&Postman::newMessage), 5);
+
+    c2.disconnect();
+    CORRADE_COMPARE(mailboxes[9]->slotConnectionCount(), 1);
+    c2.connect();
+    CORRADE_COMPARE(mailboxes[9]->slotConnectionCount(), 2);
+    c3.disconnect();
+    CORRADE_COMPARE(postman.signalConnectionCount(&Postman::paymentRequested), 1);
+
+    postman.newMessage(5, "hello");
+    postman.paymentRequested(2);
+    CORRADE_COMPARE(mailbox.messages, std::vector<std::string>{"hello"});
+    for(std::size_t i: {1, 5, 7, 9})
+        CORRADE_COMPARE(mailboxes[i]->messages, std::vector<std::string>{"hello"});
+    CORRADE_COMPARE(mailboxes[1]->money, 5);
+    CORRADE_COMPARE(mailboxes[9]->money, 3);
+
+    delete mailboxes[1];
+    delete mailboxes[5];
+    delete mailboxes[7];
+    delete mailboxes[9];
+    CORRADE_VERIFY(!c2.isConnectionPossible());
+    CORRADE_COMPARE(postman.signalConnectionCount(), 1);
+    CORRADE_VERIFY(c1.isConnected());
+}
+
+void Test::moveEmitter() {
+    int called = 0;
+    Mailbox mailbox;
+
+    Postman a;
+    Connection connection = Interconnect::connect(a, &Postman::newMessage, mailbox, &Mailbox::addMessage);
+    Interconnect::connect(a, &Postman::paymentRequested, [&called](int) { ++called; });
+
+    Postman b{std::move(a)};
+    CORRADE_VERIFY(!a.hasSignalConnections());
+    CORRADE_COMPARE(b.signalConnectionCount(), 2);
+    CORRADE_VERIFY(connection.isConnected());
+
+    /* The moved-from emitter doesn't call anything */
+    a.newMessage(60, "hello");
+    a.paymentRequested(10);
+    CORRADE_COMPARE(mailbox.money, 0);
+    CORRADE_COMPARE(called, 0);
+
+    b.newMessage(60, "hello");
+    b.paymentRequested(10);
+    CORRADE_COMPARE(mailbox.money, 60);
+    CORRADE_COMPARE(called, 1);
+
+    /* Disconnecting removes the connection from the new emitter */
+    connection.disconnect();
+    CORRADE_COMPARE(b.signalConnectionCount(), 1);
+    CORRADE_VERIFY(!mailbox.hasSlotConnections());
+
+    /* The moved-from emitter is still usable */
+    Interconnect::connect(a, &Postman::newMessage, mailbox, &Mailbox::addMessage);
+    a.newMessage(20, "world");
+    CORRADE_COMPARE(mailbox.money, 80);
+}
+
+void Test::moveEmitterAssign() {
+    Mailbox mailboxA, mailboxB;
+
+    Postman b;
+    Interconnect::connect(b, &Postman::newMessage, mailboxB, &Mailbox::addMessage);
+
+    {
+        Postman a;
+        Interconnect::connect(a, &Postman::newMessage, mailboxA, &Mailbox::addMessage);
+        Interconnect::connect(a, &Postman::paymentRequested, mailboxA, &Mailbox::pay);
+
+        b = std::move(a);
+        CORRADE_COMPARE(a.signalConnectionCount(), 1);
+        CORRADE_COMPARE(b.signalConnectionCount(), 2);
+
+        a.newMessage(10, "hello");
+        b.newMessage(60, "hello");
+        CORRADE_COMPARE(mailboxA.money, 60);
+        CORRADE_COMPARE(mailboxB.money, 10);
+    }
+
+    /* The original connections of b got destroyed with a */
+    CORRADE_VERIFY(!mailboxB.hasSlotConnections());
+    CORRADE_COMPARE(mailboxA.slotConnectionCount(), 2);
+
+    /* Destroying the receiver disconnects it from the new emitter */
+    {
+        Mailbox mailbox;
+        Interconnect::connect(b, &Postman::newMessage, mailbox, &Mailbox::addMessage);
+        CORRADE_COMPARE(b.signalConnectionCount(), 3);
+    }
+    CORRADE_COMPARE(b.signalConnectionCount(), 2);
+}
+
+void Test::moveEmitterDeferred() {
+    Mailbox mailbox;
+
+    DeferredPostman a;
+    Interconnect::connect(a, &DeferredPostman::newMessage, mailbox, &Mailbox::addMessage);
+    a.newMessage(60, "hello");
+
+    DeferredPostman b{std::move(a)};
+    CORRADE_COMPARE(a.deferredSignalCount(), 0);
+    CORRADE_COMPARE(b.deferredSignalCount(), 1);
+
+    a.flush();
+    CORRADE_COMPARE(mailbox.money, 0);
+    b.flush();
+    CORRADE_COMPARE(mailbox.money, 60);
+    CORRADE_COMPARE(mailbox.messages, std::vector<std::string>{"hello"});
+}
+
+void Test::moveEmitterThreadSafe() {
+    Mailbox mailbox;
+
+    ThreadSafePostman a;
+    Interconnect::connect(a, &ThreadSafePostman::newMessage, mailbox, &Mailbox::addMessage);
+
+    ThreadSafePostman b{std::move(a)};
+    CORRADE_VERIFY(b.isThreadSafe());
+    CORRADE_VERIFY(!a.isThreadSafe());
+    CORRADE_VERIFY(!a.hasSignalConnections());
+
+    b.newMessage(60, "hello");
+    CORRADE_COMPARE(mailbox.money, 60);
+
+    mailbox.disconnectAllSlots();
+    CORRADE_VERIFY(!b.hasSignalConnections());
+    b.newMessage(60, "hello");
+    CORRADE_COMPARE(mailbox.money, 60);
+}
+
+void Test::moveReceiver() {
+    Postman postman;
+
+    Mailbox a;
+    Connection connection = Interconnect::connect(postman, &Postman::newMessage, a, &Mailbox::addMessage);
+
+    {
+        Mailbox b{std::move(a)};
+        CORRADE_VERIFY(!a.hasSlotConnections());
+        CORRADE_COMPARE(b.slotConnectionCount(), 1);
+
+        postman.newMessage(60, "hello");
+        CORRADE_COMPARE(a.money, 0);
+        CORRADE_COMPARE(b.money, 60);
+        CORRADE_COMPARE(b.messages, std::vector<std::string>{"hello"});
+    }
+
+    /* Destroying the new receiver removed the connection */
+    CORRADE_VERIFY(!postman.hasSignalConnections());
+    CORRADE_VERIFY(!connection.isConnectionPossible());
+}
+
+void Test::moveReceiverAssign() {
+    Postman postman;
+    Mailbox b;
+    Interconnect::connect(postman, &Postman::paymentRequested, b, &Mailbox::pay);
+
+    {
+        Mailbox a;
+        Interconnect::connect(postman, &Postman::newMessage, a, &Mailbox::addMessage);
+
+        b = std::move(a);
+        CORRADE_COMPARE(a.slotConnectionCount(), 1);
+        CORRADE_COMPARE(b.slotConnectionCount(), 1);
+
+        /* The slots are called on the objects that now own the connections.
+           Only the Receiver base swaps, the Mailbox members are moved. */
+        postman.newMessage(60, "hello");
+        postman.paymentRequested(10);
+        CORRADE_COMPARE(b.money, 60);
+        CORRADE_COMPARE(a.money, -10);
+    }
+
+    /* The original connection of b got destroyed with a */
+    CORRADE_COMPARE(postman.signalConnectionCount(), 1);
+}
+
+void Test::moveReceiverQueued() {
+    Postman postman;
+
+    Mailbox a;
+    Interconnect::connect(postman, &Postman::newMessage, a, &Mailbox::addMessage, Interconnect::Queued);
+    postman.newMessage(60, "hello");
+
+    Mailbox b{std::move(a)};
+    CORRADE_COMPARE(a.dispatchQueued(), 0);
+    CORRADE_COMPARE(b.dispatchQueued(), 1);
+    CORRADE_COMPARE(b.money, 60);
+
+    postman.newMessage(20, "world");
+    CORRADE_COMPARE(b.dispatchQueued(), 1);
+    CORRADE_COMPARE(b.money, 80);
+}
+
+void Test::moveInVector() {
+    std::vector<Postman> postmen;
+    std::vector<Mailbox> mailboxes;
+
+    /* Growing both vectors moves the already connected instances around */
+    for(std::size_t i = 0; i != 100; ++i) {
+        postmen.emplace_back();
+        mailboxes.emplace_back();
+        Interconnect::connect(postmen.back(), &Postman::paymentRequested, mailboxes.back(), &Mailbox::pay);
+    }
+
+    for(std::size_t i = 0; i != 100; ++i)
+        postmen[i].paymentRequested(int(i));
+
+    for(std::size_t i = 0; i != 100; ++i) {
+        CORRADE_COMPARE(mailboxes[i].money, -int(i));
+        CORRADE_COMPARE(mailboxes[i].slotConnectionCount(), 1);
+    }
+
+    mailboxes.clear();
+    for(const Postman& postman: postmen)
+        CORRADE_VERIFY(!postman.hasSignalConnections());
+}
+
 void Test::emit() {
     Postman postman;
     Mailbox mailbox1, mailbox2, mailbox3;
@@ -484,6 +885,414 @@ void Test::templatedSignal() {
     CORRADE_COMPARE(stringMailbox.messages, std::vector<std::string>{"string"});
 }
 
+void Test::indexedSignal() {
+    IndexedPostman postman;
+    Mailbox mailbox;
+
+    /* Emitting with nothing connected */
+    postman.newMessage(5, "nobody");
+    postman.paymentRequested(5);
+
+    Connection connection = Interconnect::connect(postman, &IndexedPostman::newMessage, mailbox, &Mailbox::addMessage);
+    postman.newMessage(60, "hello");
+    CORRADE_COMPARE(mailbox.money, 60);
+
+    /* Connecting other signals moves the signal entries around */
+    Interconnect::connect(postman, &IndexedPostman::paymentCancelled, [&mailbox](int amount) {
+        mailbox.money += amount;
+    });
+    Interconnect::connect(postman, &IndexedPostman::paymentRequested, mailbox, &Mailbox::pay);
+    postman.newMessage(20, "world");
+    postman.paymentRequested(50);
+    postman.paymentCancelled(10);
+    CORRADE_COMPARE(mailbox.money, 40);
+    CORRADE_COMPARE(mailbox.messages, (std::vector<std::string>{"hello", "world"}));
+
+    /* Disconnecting keeps the entry, but there's nothing to call */
+    connection.disconnect();
+    postman.newMessage(20, "again");
+    CORRADE_COMPARE(mailbox.money, 40);
+
+    postman.disconnectAllSignals();
+    postman.paymentRequested(50);
+    CORRADE_COMPARE(mailbox.money, 40);
+}
+
+void Test::indexedSignalDuplicateIndex() {
+    IndexedPostman postman;
+    Mailbox mailbox;
+    Interconnect::connect(postman, &IndexedPostman::newMessage, mailbox, &Mailbox::addMessage);
+
+    std::ostringstream out;
+    Utility::Error::setOutput(&out);
+    postman.newMessage(60, "hello");
+    postman.parcelDelivered(10);
+    CORRADE_COMPARE(mailbox.money, 60);
+    CORRADE_COMPARE(out.str(), "Interconnect::Emitter::emit(): signal index 0 is already used by another signal\n");
+
+    /* Also detected when the cached index got stale in the meantime because
+       another signal entry was added */
+    out.str({});
+    Interconnect::connect(postman, &IndexedPostman::paymentCancelled, mailbox, &Mailbox::pay);
+    postman.parcelDelivered(10);
+    CORRADE_COMPARE(mailbox.money, 60);
+    CORRADE_COMPARE(out.str(), "Interconnect::Emitter::emit(): signal index 0 is already used by another signal\n");
+}
+
+void Test::deferredSignal() {
+    DeferredPostman postman;
+    Mailbox mailbox;
+    Interconnect::connect(postman, &DeferredPostman::newMessage, mailbox, &Mailbox::addMessage);
+    Interconnect::connect(postman, &DeferredPostman::paymentRequested, mailbox, &Mailbox::pay);
+    CORRADE_COMPARE(postman.deferredSignalCount(), 0);
+
+    /* Flushing with nothing deferred does nothing */
+    postman.flush();
+    CORRADE_COMPARE(mailbox.money, 0);
+
+    /* Nothing is called, repeated emissions are coalesced, the arguments are
+       copied */
+    {
+        std::string message = "hello";
+        postman.newMessage(10, message);
+        postman.paymentRequested(5);
+        message = "changed";
+        postman.newMessage(20, message);
+        postman.newMessage(30, "world");
+    }
+    CORRADE_COMPARE(postman.deferredSignalCount(), 2);
+    CORRADE_COMPARE(mailbox.money, 0);
+    CORRADE_VERIFY(mailbox.messages.empty());
+
+    /* Every signal is emitted once with the last arguments */
+    postman.flush();
+    CORRADE_COMPARE(postman.deferredSignalCount(), 0);
+    CORRADE_COMPARE(mailbox.money, 25);
+    CORRADE_COMPARE(mailbox.messages, std::vector<std::string>{"world"});
+
+    /* Nothing more to flush */
+    postman.flush();
+    CORRADE_COMPARE(mailbox.money, 25);
+}
+
+void Test::deferredSignalInSlot() {
+    DeferredPostman postman;
+    std::vector<int> called;
+    Interconnect::connect(postman, &DeferredPostman::paymentRequested, [&](int amount) {
+        called.push_back(amount);
+        if(amount) postman.paymentRequested(amount - 1);
+    });
+
+    /* Signals deferred in slots are emitted in the next flush */
+    postman.paymentRequested(2);
+    postman.flush();
+    CORRADE_COMPARE(called, std::vector<int>{2});
+    CORRADE_COMPARE(postman.deferredSignalCount(), 1);
+    postman.flush();
+    postman.flush();
+    CORRADE_COMPARE(called, (std::vector<int>{2, 1, 0}));
+    CORRADE_COMPARE(postman.deferredSignalCount(), 0);
+}
+
+void Test::deferredSignalDestroyEmitter() {
+    Mailbox mailbox;
+
+    {
+        DeferredPostman postman;
+        Interconnect::connect(postman, &DeferredPostman::newMessage, mailbox, &Mailbox::addMessage);
+        postman.newMessage(10, "pending");
+    }
+
+    /* The pending signals are dropped with the emitter */
+    CORRADE_COMPARE(mailbox.money, 0);
+    CORRADE_VERIFY(!mailbox.hasSlotConnections());
+}
+
+void Test::signalProfile() {
+    #ifndef CORRADE_BUILD_INTERCONNECT_PROFILING
+    CORRADE_SKIP("Interconnect profiling is not enabled in this build.");
+    #else
+    Postman postman;
+    Mailbox mailbox1, mailbox2;
+    Interconnect::connect(postman, &Postman::newMessage, mailbox1, &Mailbox::addMessage);
+    Interconnect::connect(postman, &Postman::newMessage, mailbox2, &Mailbox::addMessage);
+
+    CORRADE_COMPARE(postman.signalProfile().emitCount, 0);
+
+    postman.newMessage(60, "hello");
+    postman.newMessage(30, "ahoy");
+    /* Signals without connections are recorded too */
+    postman.paymentRequested(50);
+
+    const SignalProfile newMessage = postman.signalProfile(&Postman::newMessage);
+    CORRADE_COMPARE(newMessage.emitCount, 2);
+    CORRADE_COMPARE(newMessage.slotCallCount, 4);
+
+    const SignalProfile paymentRequested = postman.signalProfile(&Postman::paymentRequested);
+    CORRADE_COMPARE(paymentRequested.emitCount, 1);
+    CORRADE_COMPARE(paymentRequested.slotCallCount, 0);
+
+    const SignalProfile all = postman.signalProfile();
+    CORRADE_COMPARE(all.emitCount, 3);
+    CORRADE_COMPARE(all.slotCallCount, 4);
+    CORRADE_VERIFY(all.time == newMessage.time + paymentRequested.time);
+
+    postman.resetSignalProfiles();
+    CORRADE_COMPARE(postman.signalProfile().emitCount, 0);
+    CORRADE_COMPARE(postman.signalProfile(&Postman::newMessage).slotCallCount, 0);
+
+    std::ostringstream out;
+    Debug(&out) << SignalProfile{};
+    CORRADE_COMPARE(out.str(), "emits: 0, slot calls: 0, time: 0 ns\n");
+    #endif
+}
+
+void Test::signalProfileThreadSafe() {
+    #ifndef CORRADE_BUILD_INTERCONNECT_PROFILING
+    CORRADE_SKIP("Interconnect profiling is not enabled in this build.");
+    #elif defined(CORRADE_TARGET_EMSCRIPTEN)
+    CORRADE_SKIP("Threads are not available on this platform.");
+    #else
+    ThreadSafePostman postman;
+    std::atomic<int> count{0};
+    Interconnect::connect(postman, &ThreadSafePostman::paymentRequested, [&count](int amount) { count += amount; });
+
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i != 4; ++i) threads.emplace_back([&postman]() {
+        for(std::size_t j = 0; j != 1000; ++j) postman.paymentRequested(1);
+    });
+    for(std::thread& thread: threads) thread.join();
+
+    CORRADE_COMPARE(count.load(), 4000);
+    CORRADE_COMPARE(postman.signalProfile(&ThreadSafePostman::paymentRequested).emitCount, 4000);
+    CORRADE_COMPARE(postman.signalProfile(&ThreadSafePostman::paymentRequested).slotCallCount, 4000);
+    #endif
+}
+
+void Test::signalWaiter() {
+    Postman postman;
+    SignalWaiter<int, const std::string&> waiter{postman, &Postman::newMessage};
+    CORRADE_VERIFY(!waiter.isReady());
+    CORRADE_VERIFY(!waiter.await_ready());
+    CORRADE_COMPARE(postman.signalConnectionCount(), 1);
+
+    {
+        std::string message = "hello";
+        postman.newMessage(60, message);
+        message = "changed";
+    }
+    CORRADE_VERIFY(waiter.isReady());
+    CORRADE_VERIFY(waiter.await_ready());
+    CORRADE_COMPARE(std::get<0>(waiter.arguments()), 60);
+    CORRADE_COMPARE(std::get<1>(waiter.arguments()), "hello");
+
+    /* Disconnected after the first emission, further ones are ignored */
+    CORRADE_VERIFY(!postman.hasSignalConnections());
+    postman.newMessage(20, "world");
+    CORRADE_COMPARE(std::get<0>(waiter.arguments()), 60);
+}
+
+namespace {
+    struct FakeCoroutine {
+        SignalWaiter<int>* waiter;
+        int amount;
+    };
+
+    /* Mimics the std::coroutine_handle interface. Resuming destroys the
+       waiter right away, as a coroutine would do at the end of the co_await
+       expression. */
+    struct FakeCoroutineHandle {
+        static FakeCoroutineHandle from_address(void* address) {
+            return FakeCoroutineHandle{static_cast<FakeCoroutine*>(address)};
+        }
+
+        void* address() const { return coroutine; }
+
+        void resume() {
+            std::tie(coroutine->amount) = coroutine->waiter->await_resume();
+            delete coroutine->waiter;
+            coroutine->waiter = nullptr;
+        }
+
+        FakeCoroutine* coroutine;
+    };
+}
+
+void Test::signalWaiterAwait() {
+    Postman postman;
+
+    FakeCoroutine coroutine{new SignalWaiter<int>{postman, &Postman::paymentRequested}, 0};
+    coroutine.waiter->await_suspend(FakeCoroutineHandle{&coroutine});
+    CORRADE_VERIFY(coroutine.waiter);
+
+    postman.paymentRequested(50);
+    CORRADE_VERIFY(!coroutine.waiter);
+    CORRADE_COMPARE(coroutine.amount, 50);
+    CORRADE_VERIFY(!postman.hasSignalConnections());
+}
+
+void Test::signalWaiterDestroy() {
+    Postman postman;
+
+    {
+        SignalWaiter<int> waiter{postman, &Postman::paymentRequested};
+        CORRADE_VERIFY(postman.hasSignalConnections());
+    }
+
+    CORRADE_VERIFY(!postman.hasSignalConnections());
+    postman.paymentRequested(50);
+}
+
+void Test::signalWaiterDestroyEmitter() {
+    std::unique_ptr<Postman> postman{new Postman};
+    SignalWaiter<int> waiter{*postman, &Postman::paymentRequested};
+
+    postman.reset();
+    CORRADE_VERIFY(!waiter.isReady());
+}
+
+void Test::forwardSignal() {
+    Postman postman, office, depot;
+    Mailbox mailbox1, mailbox2;
+    Interconnect::connect(office, &Postman::newMessage, mailbox1, &Mailbox::addMessage);
+    Interconnect::connect(depot, &Postman::newMessage, mailbox2, &Mailbox::addMessage);
+
+    Connection connection = Interconnect::connect(postman, &Postman::newMessage, office, &Postman::newMessage);
+    Interconnect::connect(office, &Postman::newMessage, depot, &Postman::newMessage);
+    CORRADE_VERIFY(connection.isConnected());
+    CORRADE_COMPARE(postman.signalConnectionCount(), 1);
+    CORRADE_COMPARE(office.signalConnectionCount(), 2);
+
+    /* Forwarded through both levels */
+    postman.newMessage(10, "hello");
+    CORRADE_COMPARE(mailbox1.messages, std::vector<std::string>{"hello"});
+    CORRADE_COMPARE(mailbox2.messages, std::vector<std::string>{"hello"});
+    CORRADE_COMPARE(mailbox2.money, 10);
+
+    /* Disconnecting the first level */
+    connection.disconnect();
+    postman.newMessage(10, "again");
+    CORRADE_COMPARE(mailbox1.messages.size(), 1);
+
+    /* And connecting it back */
+    connection.connect();
+    postman.newMessage(20, "third");
+    CORRADE_COMPARE(mailbox1.messages.size(), 2);
+    CORRADE_COMPARE(mailbox2.money, 30);
+
+    /* Disconnecting everything on the source emitter also works */
+    postman.disconnectAllSignals();
+    CORRADE_VERIFY(!connection.isConnected());
+    postman.newMessage(20, "nobody");
+    CORRADE_COMPARE(mailbox1.messages.size(), 2);
+}
+
+void Test::forwardSignalCycle() {
+    Postman a, b, c;
+    int calledA = 0, calledB = 0, calledC = 0;
+    Interconnect::connect(a, &Postman::paymentRequested, [&calledA](int) { ++calledA; });
+    Interconnect::connect(b, &Postman::paymentRequested, [&calledB](int) { ++calledB; });
+    Interconnect::connect(c, &Postman::paymentRequested, [&calledC](int) { ++calledC; });
+
+    /* Signal forwarding to itself */
+    Interconnect::connect(a, &Postman::paymentRequested, a, &Postman::paymentRequested);
+    a.paymentRequested(0);
+    CORRADE_COMPARE(calledA, 1);
+
+    /* a -> b -> c -> a, every signal is emitted once regardless of where the
+       emission starts */
+    Interconnect::connect(a, &Postman::paymentRequested, b, &Postman::paymentRequested);
+    Interconnect::connect(b, &Postman::paymentRequested, c, &Postman::paymentRequested);
+    Interconnect::connect(c, &Postman::paymentRequested, a, &Postman::paymentRequested);
+    a.paymentRequested(0);
+    CORRADE_COMPARE(calledA, 2);
+    CORRADE_COMPARE(calledB, 1);
+    CORRADE_COMPARE(calledC, 1);
+
+    b.paymentRequested(0);
+    CORRADE_COMPARE(calledA, 3);
+    CORRADE_COMPARE(calledB, 2);
+    CORRADE_COMPARE(calledC, 2);
+
+    /* A diamond is not a cycle, the signal is emitted once for each path */
+    Postman d;
+    Interconnect::connect(a, &Postman::paymentRequested, d, &Postman::paymentRequested);
+    Interconnect::connect(b, &Postman::paymentRequested, d, &Postman::paymentRequested);
+    int calledD = 0;
+    Interconnect::connect(d, &Postman::paymentRequested, [&calledD](int) { ++calledD; });
+    a.paymentRequested(0);
+    CORRADE_COMPARE(calledA, 4);
+    CORRADE_COMPARE(calledD, 2);
+}
+
+void Test::forwardSignalDestroyTarget() {
+    Postman postman;
+    Connection connection = Interconnect::connect(postman, &Postman::newMessage, postman, &Postman::newMessage);
+
+    {
+        Postman office;
+        Interconnect::connect(postman, &Postman::newMessage, office, &Postman::newMessage);
+        Interconnect::connect(postman, &Postman::paymentRequested, office, &Postman::paymentRequested);
+        Interconnect::connect(office, &Postman::paymentRequested, postman, &Postman::paymentRequested);
+        CORRADE_COMPARE(postman.signalConnectionCount(), 3);
+    }
+
+    /* Only connections to the destroyed emitter are removed */
+    CORRADE_COMPARE(postman.signalConnectionCount(), 1);
+    CORRADE_VERIFY(connection.isConnected());
+    postman.newMessage(0, "hello");
+    postman.paymentRequested(0);
+
+    /* Destroying the source emitter removes the connection from the target */
+    Mailbox mailbox;
+    Postman office;
+    Interconnect::connect(office, &Postman::newMessage, mailbox, &Mailbox::addMessage);
+    {
+        Postman another;
+        Interconnect::connect(another, &Postman::newMessage, office, &Postman::newMessage);
+    }
+    office.newMessage(5, "hello");
+    CORRADE_COMPARE(mailbox.money, 5);
+}
+
+void Test::forwardSignalMoveTarget() {
+    Postman postman;
+    Mailbox mailbox;
+    std::unique_ptr<Postman> office{new Postman};
+    Interconnect::connect(postman, &Postman::newMessage, *office, &Postman::newMessage);
+
+    /* The connection follows the moved target */
+    Postman moved{std::move(*office)};
+    office = nullptr;
+    Interconnect::connect(moved, &Postman::newMessage, mailbox, &Mailbox::addMessage);
+    postman.newMessage(5, "hello");
+    CORRADE_COMPARE(mailbox.money, 5);
+
+    /* And is removed when the new instance is destroyed */
+    {
+        Postman assigned;
+        assigned = std::move(moved);
+        CORRADE_COMPARE(postman.signalConnectionCount(), 1);
+    }
+    CORRADE_COMPARE(postman.signalConnectionCount(), 0);
+    postman.newMessage(5, "hello");
+    CORRADE_COMPARE(mailbox.money, 5);
+}
+
+void Test::forwardSignalThreadSafe() {
+    ThreadSafePostman postman;
+    Postman office;
+    Mailbox mailbox;
+    Interconnect::connect(postman, &ThreadSafePostman::newMessage, office, &Postman::newMessage);
+    Interconnect::connect(office, &Postman::newMessage, postman, &ThreadSafePostman::newMessage);
+    Interconnect::connect(office, &Postman::newMessage, mailbox, &Mailbox::addMessage);
+
+    postman.newMessage(5, "hello");
+    CORRADE_COMPARE(mailbox.money, 5);
+    office.newMessage(5, "hello");
+    CORRADE_COMPARE(mailbox.money, 10);
+}
+
 void Test::changeConnectionsInSlot() {
     Postman postman;
     Mailbox mailbox;
@@ -520,6 +1329,107 @@ void Test::changeConnectionsInSlot() {
     CORRADE_COMPARE(mailbox.money, 19);
 }
 
+void Test::disconnectInSlot() {
+    Postman postman;
+    std::vector<int> called;
+
+    Connection a = Interconnect::connect(postman, &Postman::paymentRequested, [&called](int) {
+        called.push_back(0);
+    });
+    Connection *b = nullptr, *c = nullptr;
+    Connection bConnection = Interconnect::connect(postman, &Postman::paymentRequested, [&](int amount) {
+        called.push_back(1);
+
+        /* Disconnect a slot that wasn't called yet and this one */
+        c->disconnect();
+        b->disconnect();
+
+        /* Nested emission sees the changes as well */
+        if(amount) postman.paymentRequested(0);
+    });
+    Connection cConnection = Interconnect::connect(postman, &Postman::paymentRequested, [&called](int) {
+        called.push_back(2);
+    });
+    b = &bConnection;
+    c = &cConnection;
+    Interconnect::connect(postman, &Postman::paymentRequested, [&called](int amount) {
+        called.push_back(amount ? 3 : 30);
+    });
+
+    /* Every slot is called at most once, removed ones are skipped */
+    postman.paymentRequested(1);
+    CORRADE_COMPARE(called, (std::vector<int>{0, 1, 0, 30, 3}));
+    CORRADE_COMPARE(postman.signalConnectionCount(&Postman::paymentRequested), 2);
+
+    called.clear();
+    a.disconnect();
+    postman.paymentRequested(1);
+    CORRADE_COMPARE(called, std::vector<int>{3});
+    CORRADE_COMPARE(postman.signalConnectionCount(&Postman::paymentRequested), 1);
+}
+
+void Test::disconnectOtherSignalInSlot() {
+    Postman postman;
+    Mailbox mailboxes[6];
+    std::vector<Connection> connections;
+    for(Mailbox& mailbox: mailboxes)
+        connections.push_back(Interconnect::connect(postman, &Postman::newMessage, mailbox, &Mailbox::addMessage));
+
+    /* Removing most connections of another signal during an emission
+       postpones compacting its slot array until the emission ends, after
+       which the remaining connections have to be still in order */
+    Interconnect::connect(postman, &Postman::paymentRequested, [&](int amount) {
+        if(!amount) return;
+        for(std::size_t i: {0, 1, 3, 4}) connections[i].disconnect();
+        postman.paymentRequested(0);
+    });
+    postman.paymentRequested(1);
+    CORRADE_COMPARE(postman.signalConnectionCount(&Postman::newMessage), 2);
+
+    postman.newMessage(5, "hello");
+    CORRADE_COMPARE(mailboxes[0].money, 0);
+    CORRADE_COMPARE(mailboxes[2].money, 5);
+    CORRADE_COMPARE(mailboxes[5].money, 5);
+
+    connections[2].disconnect();
+    connections[0].connect();
+    postman.newMessage(10, "again");
+    CORRADE_COMPARE(mailboxes[0].money, 10);
+    CORRADE_COMPARE(mailboxes[2].money, 5);
+    CORRADE_COMPARE(mailboxes[5].money, 15);
+    CORRADE_COMPARE(postman.signalConnectionCount(&Postman::newMessage), 2);
+}
+
+void Test::disconnectSignalInSlot() {
+    Postman postman;
+    std::vector<int> called;
+
+    /* The connection objects keep the disconnecting slots alive. Slots after
+       them are not called anymore. */
+    Connection a = Interconnect::connect(postman, &Postman::paymentRequested, [&](int) {
+        called.push_back(0);
+        postman.disconnectSignal(&Postman::paymentRequested);
+    });
+    Interconnect::connect(postman, &Postman::paymentRequested, [&called](int) {
+        called.push_back(1);
+    });
+    postman.paymentRequested(1);
+    CORRADE_COMPARE(called, std::vector<int>{0});
+    CORRADE_COMPARE(postman.signalConnectionCount(&Postman::paymentRequested), 0);
+
+    called.clear();
+    Connection b = Interconnect::connect(postman, &Postman::newMessage, [&](int, const std::string&) {
+        called.push_back(2);
+        postman.disconnectAllSignals();
+    });
+    Interconnect::connect(postman, &Postman::newMessage, [&called](int, const std::string&) {
+        called.push_back(3);
+    });
+    postman.newMessage(1, "hello");
+    CORRADE_COMPARE(called, std::vector<int>{2});
+    CORRADE_VERIFY(!postman.hasSignalConnections());
+}
+
 void Test::deleteReceiverInSlot() {
     class SuicideMailbox: public Interconnect::Receiver {
         public:
@@ -558,6 +1468,569 @@ void Test::function() {
     CORRADE_COMPARE(out.str(), "hello\n");
 }
 
+void Test::functor() {
+    Postman postman;
+    int total = 0;
+    std::vector<std::string> messages;
+    Interconnect::connect(postman, &Postman::paymentRequested, [&total](int amount) { total += amount; });
+    Connection connection = Interconnect::connect(postman, &Postman::newMessage, [&total, &messages](int price, const std::string& message) {
+        total -= price;
+        messages.push_back(message);
+    });
+
+    /* Small captures are stored inline */
+    CORRADE_VERIFY((Implementation::FunctorConnectionData<int>::IsInline<std::pair<int*, std::vector<std::string>*>>::value));
+
+    postman.paymentRequested(50);
+    postman.newMessage(20, "hello");
+    CORRADE_COMPARE(total, 30);
+    CORRADE_COMPARE(messages, std::vector<std::string>{"hello"});
+
+    connection.disconnect();
+    postman.newMessage(20, "heyy");
+    CORRADE_COMPARE(total, 30);
+    CORRADE_COMPARE(messages, std::vector<std::string>{"hello"});
+}
+
+void Test::functorHeap() {
+    struct Large {
+        void operator()(int amount) {
+            for(int& i: data) i += amount;
+            *total += amount;
+        }
+
+        int data[32];
+        int* total;
+    };
+
+    CORRADE_VERIFY(!Implementation::FunctorConnectionData<int>::IsInline<Large>::value);
+
+    Postman postman;
+    int total = 0;
+    Large large{{}, &total};
+    Interconnect::connect(postman, &Postman::paymentRequested, large);
+
+    postman.paymentRequested(7);
+    postman.paymentRequested(3);
+    CORRADE_COMPARE(total, 10);
+}
+
+void Test::functorDestruction() {
+    struct Counted {
+        Counted(int* destructed): destructed(destructed) {}
+        Counted(const Counted& other): destructed(other.destructed) {}
+        ~Counted() { ++*destructed; }
+
+        void operator()(int) {}
+
+        int* destructed;
+    };
+
+    struct LargeCounted: Counted {
+        LargeCounted(int* destructed): Counted{destructed} {}
+
+        char padding[128]{};
+    };
+
+    int destructed = 0;
+    {
+        Postman postman;
+        Connection c1 = Interconnect::connect(postman, &Postman::paymentRequested, Counted{&destructed});
+        Interconnect::connect(postman, &Postman::paymentRequested, LargeCounted{&destructed});
+
+        /* Temporaries and moved-from copies */
+        const int temporaries = destructed;
+
+        /* Disconnected functor stays alive as long as the connection object */
+        c1.disconnect();
+        CORRADE_COMPARE(destructed, temporaries);
+
+        postman.disconnectAllSignals();
+        CORRADE_COMPARE(destructed, temporaries + 1);
+
+        destructed = 0;
+    }
+
+    CORRADE_COMPARE(destructed, 1);
+}
+
+void Test::priority() {
+    Postman postman;
+    std::string order;
+    Connection a = Interconnect::connect(postman, &Postman::paymentRequested, [&order](int) { order += 'a'; });
+    Connection b = Interconnect::connect(postman, &Postman::paymentRequested, [&order](int) { order += 'b'; });
+    Interconnect::connect(postman, &Postman::paymentRequested, [&order](int) { order += 'c'; }).setPriority(10);
+    Interconnect::connect(postman, &Postman::paymentRequested, [&order](int) { order += 'd'; }).setPriority(-5);
+    Interconnect::connect(postman, &Postman::paymentRequested, [&order](int) { order += 'e'; }).setPriority(10);
+    CORRADE_COMPARE(a.priority(), 0);
+
+    /* Higher priority first, same priorities in order of connecting */
+    postman.paymentRequested(0);
+    CORRADE_COMPARE(order, "ceabd");
+
+    /* Changing the priority of a live connection */
+    order.clear();
+    a.setPriority(20);
+    CORRADE_COMPARE(a.priority(), 20);
+    postman.paymentRequested(0);
+    CORRADE_COMPARE(order, "acebd");
+
+    /* New connection with default priority fills the hole after the removed
+       one and still goes after the ones with the same priority */
+    order.clear();
+    b.disconnect();
+    Interconnect::connect(postman, &Postman::paymentRequested, [&order](int) { order += 'f'; });
+    postman.paymentRequested(0);
+    CORRADE_COMPARE(order, "acefd");
+    CORRADE_COMPARE(postman.signalConnectionCount(&Postman::paymentRequested), 5);
+
+    /* Removing a connection after reordering removes the right one */
+    order.clear();
+    a.disconnect();
+    postman.paymentRequested(0);
+    CORRADE_COMPARE(order, "cefd");
+}
+
+void Test::priorityDisconnected() {
+    Postman postman;
+    std::string order;
+    Connection a = Interconnect::connect(postman, &Postman::paymentRequested, [&order](int) { order += 'a'; });
+    Interconnect::connect(postman, &Postman::paymentRequested, [&order](int) { order += 'b'; });
+
+    /* Priority of disconnected connection is applied when connecting again */
+    a.disconnect();
+    a.setPriority(-1);
+    CORRADE_COMPARE(a.priority(), -1);
+    postman.paymentRequested(0);
+    CORRADE_COMPARE(order, "b");
+
+    order.clear();
+    a.connect();
+    postman.paymentRequested(0);
+    CORRADE_COMPARE(order, "ba");
+
+    /* Connection that's not possible anymore does nothing */
+    {
+        Postman another;
+        a = Interconnect::connect(another, &Postman::paymentRequested, [](int) {});
+    }
+    CORRADE_VERIFY(!a.isConnectionPossible());
+    a.setPriority(5);
+    CORRADE_COMPARE(a.priority(), 0);
+}
+
+void Test::priorityInSlot() {
+    Postman postman;
+    std::string order;
+    bool connected = false;
+    Interconnect::connect(postman, &Postman::paymentRequested, [&](int) {
+        order += 'a';
+        if(!connected) {
+            Interconnect::connect(postman, &Postman::paymentRequested, [&order](int) { order += 'b'; }).setPriority(100);
+            connected = true;
+        }
+    });
+    Interconnect::connect(postman, &Postman::paymentRequested, [&order](int) { order += 'c'; }).setPriority(-1);
+
+    /* Connection made during emission is called after the existing ones */
+    postman.paymentRequested(0);
+    CORRADE_COMPARE(order, "acb");
+
+    /* And sorted by priority in the next emission */
+    order.clear();
+    postman.paymentRequested(0);
+    CORRADE_COMPARE(order, "bac");
+}
+
+namespace {
+    bool consumingFunction(int amount) { return amount > 100; }
+}
+
+void Test::consumed() {
+    class ConsumingMailbox: public Interconnect::Receiver {
+        public:
+            ConsumingMailbox(): money(0) {}
+
+            bool pay(int amount) {
+                if(amount > money) return false;
+                money -= amount;
+                return true;
+            }
+
+            int money;
+    };
+
+    Postman postman;
+    ConsumingMailbox consuming;
+    Mailbox mailbox;
+    Interconnect::connect(postman, &Postman::paymentRequested, mailbox, &Mailbox::pay);
+    Interconnect::connect(postman, &Postman::paymentRequested, consuming, &ConsumingMailbox::pay).setPriority(1);
+    Interconnect::connect(postman, &Postman::paymentRequested, consumingFunction).setPriority(2);
+    int called = 0;
+    Interconnect::connect(postman, &Postman::paymentRequested, [&called](int) {
+        ++called;
+        return false;
+    }).setPriority(3);
+
+    /* Nobody consumes it */
+    postman.paymentRequested(10);
+    CORRADE_COMPARE(called, 1);
+    CORRADE_COMPARE(consuming.money, 0);
+    CORRADE_COMPARE(mailbox.money, -10);
+
+    /* Consuming mailbox can pay, the plain one doesn't get anything */
+    consuming.money = 50;
+    postman.paymentRequested(20);
+    CORRADE_COMPARE(called, 2);
+    CORRADE_COMPARE(consuming.money, 30);
+    CORRADE_COMPARE(mailbox.money, -10);
+
+    /* Consumed by the function already */
+    postman.paymentRequested(200);
+    CORRADE_COMPARE(called, 3);
+    CORRADE_COMPARE(consuming.money, 30);
+    CORRADE_COMPARE(mailbox.money, -10);
+}
+
+void Test::consumedThreadSafe() {
+    ThreadSafePostman postman;
+    Mailbox mailbox;
+    int value = 0;
+    Interconnect::connect(postman, &ThreadSafePostman::paymentRequested, mailbox, &Mailbox::pay);
+    Interconnect::connect(postman, &ThreadSafePostman::paymentRequested, [value](int amount) {
+        return amount > value;
+    }).setPriority(1);
+
+    postman.paymentRequested(0);
+    CORRADE_COMPARE(mailbox.money, 0);
+
+    postman.paymentRequested(15);
+    CORRADE_COMPARE(mailbox.money, 0);
+
+    postman.paymentRequested(-5);
+    CORRADE_COMPARE(mailbox.money, 5);
+}
+
+void Test::connectionDataPool() {
+    /* Freed block is reused for the next allocation of the same size class */
+    void* a = Implementation::allocateConnectionData(40);
+    Implementation::deallocateConnectionData(a, 40);
+    void* b = Implementation::allocateConnectionData(48);
+    #ifndef CORRADE_GCC47_COMPATIBILITY
+    CORRADE_VERIFY(a == b);
+    #endif
+
+    /* Blocks of the same size class don't overlap */
+    void* c = Implementation::allocateConnectionData(48);
+    CORRADE_VERIFY(c != b);
+    CORRADE_VERIFY(static_cast<char*>(c) + 48 <= static_cast<char*>(b) || static_cast<char*>(b) + 48 <= static_cast<char*>(c));
+    Implementation::deallocateConnectionData(b, 48);
+    Implementation::deallocateConnectionData(c, 48);
+
+    /* Large sizes are not pooled, but work as well */
+    void* d = Implementation::allocateConnectionData(1024);
+    CORRADE_VERIFY(d);
+    Implementation::deallocateConnectionData(d, 1024);
+
+    /* Reconnecting doesn't exhaust anything */
+    Postman postman;
+    Mailbox mailbox;
+    for(std::size_t i = 0; i != 1000; ++i) {
+        Connection connection = Interconnect::connect(postman, &Postman::newMessage, mailbox, &Mailbox::addMessage);
+        connection.disconnect();
+    }
+    CORRADE_VERIFY(!postman.hasSignalConnections());
+    CORRADE_VERIFY(!postman.hasSignalConnections(&Postman::newMessage));
+    CORRADE_COMPARE(postman.signalConnectionCount(&Postman::newMessage), 0);
+}
+
+void Test::connectionDataPoolThreadExit() {
+    Postman postman;
+    Mailbox mailbox;
+
+    /* Connection data allocated in a thread that exited in the meantime are
+       freed in this one */
+    std::vector<Connection> connections;
+    std::thread{[&]() {
+        for(std::size_t i = 0; i != 100; ++i)
+            connections.push_back(Interconnect::connect(postman, &Postman::newMessage, mailbox, &Mailbox::addMessage));
+    }}.join();
+    CORRADE_COMPARE(postman.signalConnectionCount(), 100);
+
+    postman.newMessage(1, "hello");
+    CORRADE_COMPARE(mailbox.money, 100);
+
+    for(Connection& connection: connections) connection.disconnect();
+    CORRADE_VERIFY(!postman.hasSignalConnections());
+
+    /* Connection data freed in a thread that exits right after are reused
+       here */
+    std::thread{[&]() {
+        Interconnect::connect(postman, &Postman::newMessage, mailbox, &Mailbox::addMessage);
+        postman.disconnectAllSignals();
+    }}.join();
+    Interconnect::connect(postman, &Postman::newMessage, mailbox, &Mailbox::addMessage);
+    postman.newMessage(1, "hello");
+    CORRADE_COMPARE(mailbox.money, 101);
+}
+
+namespace {
+    /* Destroyed only after thread_locals of the main thread, the connection
+       data have to be freed without the thread pool */
+    Postman staticPostman;
+    Mailbox staticMailbox;
+}
+
+void Test::connectionDataPoolStaticEmitter() {
+    Interconnect::connect(staticPostman, &Postman::newMessage, staticMailbox, &Mailbox::addMessage);
+    Interconnect::connect(staticPostman, &Postman::paymentRequested, staticMailbox, &Mailbox::pay);
+    Interconnect::connect(staticPostman, &Postman::paymentRequested, [](int) {});
+
+    staticPostman.newMessage(20, "hello");
+    staticPostman.paymentRequested(5);
+    CORRADE_COMPARE(staticMailbox.money, 15);
+    CORRADE_COMPARE(staticPostman.signalConnectionCount(), 3);
+}
+
+void Test::threadSafe() {
+    CORRADE_VERIFY(!Postman{}.isThreadSafe());
+
+    ThreadSafePostman postman;
+    CORRADE_VERIFY(postman.isThreadSafe());
+
+    Mailbox mailbox1, mailbox2;
+    Connection connection = Interconnect::connect(postman, &ThreadSafePostman::newMessage, mailbox1, &Mailbox::addMessage);
+    Interconnect::connect(postman, &ThreadSafePostman::newMessage, mailbox2, &Mailbox::addMessage);
+    Interconnect::connect(postman, &ThreadSafePostman::paymentRequested, mailbox1, &Mailbox::pay);
+    CORRADE_COMPARE(postman.signalConnectionCount(), 3);
+
+    postman.newMessage(60, "hello");
+    postman.paymentRequested(10);
+    CORRADE_COMPARE(mailbox1.money, 50);
+    CORRADE_COMPARE(mailbox2.money, 60);
+
+    /* Disconnecting in a slot doesn't affect the emission in progress, as it
+       walks a snapshot of the connections */
+    int called = 0;
+    Connection self = Interconnect::connect(postman, &ThreadSafePostman::newMessage, [&](int, const std::string&) {
+        ++called;
+        connection.disconnect();
+    });
+    postman.newMessage(5, "again");
+    CORRADE_COMPARE(called, 1);
+    CORRADE_VERIFY(!connection.isConnected());
+    CORRADE_COMPARE(mailbox1.money, 55);
+    CORRADE_COMPARE(mailbox2.money, 65);
+
+    postman.newMessage(5, "third");
+    CORRADE_COMPARE(called, 2);
+    CORRADE_COMPARE(mailbox1.money, 55);
+    CORRADE_COMPARE(mailbox2.money, 70);
+
+    /* Destroying a receiver removes its connections */
+    {
+        Mailbox mailbox3;
+        Interconnect::connect(postman, &ThreadSafePostman::newMessage, mailbox3, &Mailbox::addMessage);
+        CORRADE_COMPARE(postman.signalConnectionCount(&ThreadSafePostman::newMessage), 3);
+    }
+    CORRADE_COMPARE(postman.signalConnectionCount(&ThreadSafePostman::newMessage), 2);
+
+    postman.disconnectAllSignals();
+    CORRADE_VERIFY(!postman.hasSignalConnections());
+    CORRADE_VERIFY(!self.isConnected());
+    postman.newMessage(5, "nobody");
+    CORRADE_COMPARE(called, 2);
+}
+
+void Test::threadSafeConcurrentEmit() {
+    #ifdef CORRADE_TARGET_EMSCRIPTEN
+    CORRADE_SKIP("Threads are not available on this platform.");
+    #else
+    ThreadSafePostman postman;
+
+    std::atomic<std::size_t> permanent{0}, toggled{0};
+    Interconnect::connect(postman, &ThreadSafePostman::paymentRequested, [&permanent](int amount) {
+        permanent += amount;
+    });
+
+    enum: std::size_t { ThreadCount = 4, EmitCount = 10000 };
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i != ThreadCount; ++i) threads.emplace_back([&postman]() {
+        for(std::size_t i = 0; i != EmitCount; ++i) postman.paymentRequested(1);
+    });
+
+    /* Connect and disconnect another slot while the other threads emit */
+    for(std::size_t i = 0; i != 1000; ++i) {
+        Connection connection = Interconnect::connect(postman, &ThreadSafePostman::paymentRequested, [&toggled](int amount) {
+            toggled += amount;
+        });
+        connection.disconnect();
+    }
+
+    for(std::thread& thread: threads) thread.join();
+
+    CORRADE_COMPARE(permanent.load(), std::size_t(ThreadCount*EmitCount));
+    CORRADE_VERIFY(toggled.load() <= ThreadCount*EmitCount);
+    CORRADE_COMPARE(postman.signalConnectionCount(&ThreadSafePostman::paymentRequested), 1);
+    #endif
+}
+
+void Test::queued() {
+    Postman postman;
+    Mailbox mailbox;
+    CORRADE_COMPARE(mailbox.dispatchQueued(), 0);
+
+    Connection connection = Interconnect::connect(postman, &Postman::newMessage, mailbox, &Mailbox::addMessage, Interconnect::Queued);
+    Interconnect::connect(postman, &Postman::paymentRequested, mailbox, &Mailbox::pay, Interconnect::Queued);
+    CORRADE_VERIFY(connection.isConnected());
+    CORRADE_COMPARE(postman.signalConnectionCount(), 2);
+    CORRADE_COMPARE(mailbox.slotConnectionCount(), 2);
+
+    /* Emitting doesn't call anything, the arguments are copied */
+    {
+        std::string message = "hello";
+        postman.newMessage(60, message);
+        message = "changed";
+        postman.paymentRequested(10);
+        postman.newMessage(20, "world");
+    }
+    CORRADE_COMPARE(mailbox.money, 0);
+    CORRADE_VERIFY(mailbox.messages.empty());
+
+    /* Everything is called in order of emission */
+    CORRADE_COMPARE(mailbox.dispatchQueued(), 3);
+    CORRADE_COMPARE(mailbox.money, 70);
+    CORRADE_COMPARE(mailbox.messages, (std::vector<std::string>{"hello", "world"}));
+
+    /* Nothing more to dispatch */
+    CORRADE_COMPARE(mailbox.dispatchQueued(), 0);
+    CORRADE_COMPARE(mailbox.money, 70);
+}
+
+void Test::queuedDisconnect() {
+    Mailbox mailbox;
+
+    {
+        Postman postman;
+        Connection connection = Interconnect::connect(postman, &Postman::newMessage, mailbox, &Mailbox::addMessage, Interconnect::Queued);
+
+        /* Events of removed connections are dropped */
+        postman.newMessage(60, "hello");
+        connection.disconnect();
+        CORRADE_COMPARE(mailbox.dispatchQueued(), 0);
+
+        /* Reconnected connection is queued again */
+        connection.connect();
+        postman.newMessage(10, "again");
+        CORRADE_COMPARE(mailbox.dispatchQueued(), 1);
+        CORRADE_COMPARE(mailbox.money, 10);
+
+        postman.newMessage(5, "all slots");
+        mailbox.disconnectAllSlots();
+        CORRADE_COMPARE(mailbox.dispatchQueued(), 0);
+
+        Interconnect::connect(postman, &Postman::newMessage, mailbox, &Mailbox::addMessage, Interconnect::Queued);
+        postman.newMessage(5, "emitter");
+    }
+
+    /* Destroyed emitter removes the connections as well */
+    CORRADE_COMPARE(mailbox.dispatchQueued(), 0);
+    CORRADE_COMPARE(mailbox.money, 10);
+    CORRADE_COMPARE(mailbox.messages, std::vector<std::string>{"again"});
+}
+
+void Test::queuedDisconnectReconnect() {
+    Postman postman;
+    Mailbox mailbox;
+    Connection connection = Interconnect::connect(postman, &Postman::newMessage, mailbox, &Mailbox::addMessage, Interconnect::Queued);
+
+    /* Events queued before the disconnect are dropped even if the same
+       connection is established again before dispatching */
+    postman.newMessage(60, "hello");
+    connection.disconnect();
+    connection.connect();
+    postman.newMessage(10, "again");
+    CORRADE_COMPARE(mailbox.dispatchQueued(), 1);
+    CORRADE_COMPARE(mailbox.money, 10);
+    CORRADE_COMPARE(mailbox.messages, std::vector<std::string>{"again"});
+
+    /* Disconnecting all slots and reconnecting as well */
+    postman.newMessage(5, "dropped");
+    mailbox.disconnectAllSlots();
+    connection.connect();
+    CORRADE_COMPARE(mailbox.dispatchQueued(), 0);
+    CORRADE_COMPARE(mailbox.money, 10);
+}
+
+void Test::queuedDestroyReceiver() {
+    Postman postman;
+
+    {
+        Mailbox mailbox;
+        Interconnect::connect(postman, &Postman::newMessage, mailbox, &Mailbox::addMessage, Interconnect::Queued);
+        postman.newMessage(60, "hello");
+        postman.newMessage(60, "pending");
+    }
+
+    /* The pending events are dropped with the receiver and the connection is
+       removed */
+    CORRADE_VERIFY(!postman.hasSignalConnections());
+    postman.newMessage(60, "nobody");
+}
+
+void Test::queuedDeleteReceiverInSlot() {
+    class SelfDeletingMailbox: public Interconnect::Receiver {
+        public:
+            explicit SelfDeletingMailbox(int& called): called(called) {}
+
+            void receive(int) {
+                ++called;
+                delete this;
+            }
+
+            int& called;
+    };
+
+    Postman postman;
+    int called = 0;
+    auto mailbox = new SelfDeletingMailbox{called};
+    Interconnect::connect(postman, &Postman::paymentRequested, *mailbox, &SelfDeletingMailbox::receive, Interconnect::Queued);
+    postman.paymentRequested(1);
+    postman.paymentRequested(2);
+
+    /* The second event is dropped as the receiver is gone */
+    CORRADE_COMPARE(mailbox->dispatchQueued(), 1);
+    CORRADE_COMPARE(called, 1);
+    CORRADE_VERIFY(!postman.hasSignalConnections());
+}
+
+void Test::queuedThreadSafe() {
+    #ifdef CORRADE_TARGET_EMSCRIPTEN
+    CORRADE_SKIP("Threads are not available on this platform.");
+    #else
+    ThreadSafePostman postman;
+    Mailbox mailbox;
+    Interconnect::connect(postman, &ThreadSafePostman::paymentRequested, mailbox, &Mailbox::pay, Interconnect::Queued);
+
+    enum: std::size_t { ThreadCount = 4, EmitCount = 10000 };
+    std::vector<std::thread> threads;
+    for(std::size_t i = 0; i != ThreadCount; ++i) threads.emplace_back([&postman]() {
+        for(std::size_t i = 0; i != EmitCount; ++i) postman.paymentRequested(1);
+    });
+
+    /* Dispatch while the other threads emit */
+    std::size_t dispatched = 0;
+    while(dispatched != ThreadCount*EmitCount)
+        dispatched += mailbox.dispatchQueued();
+
+    for(std::thread& thread: threads) thread.join();
+
+    CORRADE_COMPARE(dispatched, std::size_t(ThreadCount*EmitCount));
+    CORRADE_COMPARE(mailbox.money, -int(ThreadCount*EmitCount));
+    CORRADE_COMPARE(mailbox.dispatchQueued(), 0);
+    #endif
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Corrade::Interconnect::Test::Test)
@@ -30,11 +30,17 @@
 #include <array>
 #include <algorithm>
 #include <fstream>
+#include <limits>
 
 /* Unix */
 #ifdef CORRADE_TARGET_UNIX
 #include <sys/stat.h>
 #include <dirent.h>
+#ifndef CORRADE_TARGET_NACL
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 /* Windows */
 /** @todo remove the superfluous includes when mingw is fixed (otherwise causes undefined EXTERN_C error) */
@@ -316,6 +322,77 @@ std::string Directory::readString(const std::string& filename) {
     return {data, data.size()};
 }
 
+#if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_NACL)
+namespace {
+    void adviseMapped(void* const data, const std::size_t size, const Directory::MapHint hint) {
+        int advice;
+        switch(hint) {
+            case Directory::MapHint::Normal: return;
+            case Directory::MapHint::Sequential: advice = POSIX_MADV_SEQUENTIAL; break;
+            case Directory::MapHint::Random: advice = POSIX_MADV_RANDOM; break;
+            case Directory::MapHint::WillNeed: advice = POSIX_MADV_WILLNEED; break;
+            default: return;
+        }
+
+        /* The hint is only advisory, ignore failures */
+        posix_madvise(data, size, advice);
+    }
+}
+
+void Directory::MapDeleter::operator()(const char* const data, const std::size_t size) {
+    if(data) munmap(const_cast<char*>(data), size);
+}
+
+Containers::Array<const char, Directory::MapDeleter> Directory::mapRead(const std::string& filename, const MapHint hint) {
+    const int fd = open(filename.c_str(), O_RDONLY|O_CLOEXEC);
+    if(fd == -1) return nullptr;
+
+    /* Only regular files with known size can be mapped, zero-sized mappings
+       are not allowed. Files larger than the address space (possible on
+       32-bit systems) can't be mapped either. */
+    struct stat st;
+    if(fstat(fd, &st) == -1 || !S_ISREG(st.st_mode) || st.st_size <= 0 || static_cast<unsigned long long>(st.st_size) > std::numeric_limits<std::size_t>::max()) {
+        close(fd);
+        return nullptr;
+    }
+
+    const std::size_t size = st.st_size;
+    void* const data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    /* The mapping stays valid after closing the file */
+    close(fd);
+    if(data == MAP_FAILED) return nullptr;
+
+    adviseMapped(data, size, hint);
+    return Containers::Array<const char, MapDeleter>{static_cast<const char*>(data), size, MapDeleter{}};
+}
+
+Containers::Array<char, Directory::MapDeleter> Directory::map(const std::string& filename, const std::size_t size, const MapHint hint) {
+    /* Zero-sized mappings are not allowed, the size also has to fit into the
+       file offset type. Checked before opening so an invalid call doesn't
+       truncate an existing file. */
+    if(!size || size > static_cast<unsigned long long>(std::numeric_limits<off_t>::max()))
+        return nullptr;
+
+    const int fd = open(filename.c_str(), O_RDWR|O_CREAT|O_TRUNC|O_CLOEXEC, S_IRUSR|S_IWUSR|S_IRGRP|S_IROTH);
+    if(fd == -1) return nullptr;
+
+    if(ftruncate(fd, size) == -1) {
+        close(fd);
+        return nullptr;
+    }
+
+    void* const data = mmap(nullptr, size, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+
+    /* The mapping stays valid after closing the file */
+    close(fd);
+    if(data == MAP_FAILED) return nullptr;
+
+    adviseMapped(data, size, hint);
+    return Containers::Array<char, MapDeleter>{static_cast<char*>(data), size, MapDeleter{}};
+}
+#endif
+
 bool Directory::write(const std::string& filename, const Containers::ArrayView<const void> data) {
     std::ofstream file(filename, std::ofstream::binary);
     if(!file) return false;
@@ -29,6 +29,7 @@
  * @brief Class @ref Corrade::Utility::Directory
  */
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -209,6 +210,79 @@ class CORRADE_UTILITY_EXPORT Directory {
          */
         static std::string readString(const std::string& filename);
 
+        #if (defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_NACL)) || defined(DOXYGEN_GENERATING_OUTPUT)
+        /**
+         * @brief Memory-mapped file deleter
+         *
+         * Unmaps memory returned by @ref map() or @ref mapRead().
+         * @partialsupport Available only on @ref CORRADE_TARGET_UNIX "Unix"
+         *      platforms, not available in @ref CORRADE_TARGET_NACL "NaCl".
+         */
+        class CORRADE_UTILITY_EXPORT MapDeleter {
+            public:
+                /** @brief Unmap the memory */
+                void operator()(const char* data, std::size_t size);
+        };
+
+        /**
+         * @brief Memory access hint
+         *
+         * @see @ref map(), @ref mapRead()
+         * @partialsupport Available only on @ref CORRADE_TARGET_UNIX "Unix"
+         *      platforms, not available in @ref CORRADE_TARGET_NACL "NaCl".
+         */
+        enum class MapHint: unsigned char {
+            /** No special treatment */
+            Normal,
+
+            /**
+             * Expect sequential access. The pages can be read ahead more
+             * aggressively and freed soon after being accessed.
+             */
+            Sequential,
+
+            /** Expect random access. Less data is read ahead. */
+            Random,
+
+            /** Expect access in the near future, start paging the data in. */
+            WillNeed
+        };
+
+        /**
+         * @brief Map file for reading
+         * @param filename  File to map
+         * @param hint      Memory access hint
+         *
+         * Maps whole file into memory without copying it. The pages are read
+         * from the file lazily on first access and the mapping is removed
+         * when the returned array is destroyed. Returns `nullptr` if the file
+         * can't be opened, isn't a regular file, is empty or can't be mapped,
+         * use @ref read() for non-seekable files.
+         * @see @ref map(), @ref fileExists()
+         * @partialsupport Available only on @ref CORRADE_TARGET_UNIX "Unix"
+         *      platforms, not available in @ref CORRADE_TARGET_NACL "NaCl".
+         */
+        static Containers::Array<const char, MapDeleter> mapRead(const std::string& filename, MapHint hint = MapHint::Normal);
+
+        /**
+         * @brief Map file for reading and writing
+         * @param filename  File to map
+         * @param size      File size
+         * @param hint      Memory access hint
+         *
+         * If the file doesn't exist, it's created, if it exists, it's
+         * truncated. The file is then resized to @p size and mapped into
+         * memory. Changes to the data are written back to the file, at the
+         * latest when the returned array is destroyed. Returns `nullptr` if
+         * the file can't be created, @p size is zero or the file can't be
+         * mapped.
+         * @see @ref mapRead(), @ref write()
+         * @partialsupport Available only on @ref CORRADE_TARGET_UNIX "Unix"
+         *      platforms, not available in @ref CORRADE_TARGET_NACL "NaCl".
+         */
+        static Containers::Array<char, MapDeleter> map(const std::string& filename, std::size_t size, MapHint hint = MapHint::Normal);
+        #endif
+
         /**
          * @brief Write array into file
          *
@@ -23,6 +23,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
+
 #include "Corrade/Containers/Array.h"
 #include "Corrade/TestSuite/Tester.h"
 #include "Corrade/TestSuite/Compare/Container.h"
@@ -55,6 +57,10 @@ struct DirectoryTest: TestSuite::Tester {
     void readEmpty();
     void readNonSeekable();
     void write();
+    void mapRead();
+    void mapReadEmpty();
+    void mapReadHint();
+    void map();
 };
 
 DirectoryTest::DirectoryTest() {
@@ -76,7 +82,11 @@ DirectoryTest::DirectoryTest() {
               &DirectoryTest::read,
               &DirectoryTest::readEmpty,
               &DirectoryTest::readNonSeekable,
-              &DirectoryTest::write});
+              &DirectoryTest::write,
+              &DirectoryTest::mapRead,
+              &DirectoryTest::mapReadEmpty,
+              &DirectoryTest::mapReadHint,
+              &DirectoryTest::map});
 }
 
 void DirectoryTest::path() {
@@ -369,6 +379,80 @@ void DirectoryTest::write() {
         TestSuite::Compare::File);
 }
 
+void DirectoryTest::mapRead() {
+    #if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_NACL)
+    {
+        const auto data = Directory::mapRead(Directory::join(DIRECTORY_TEST_DIR, "file"));
+        CORRADE_VERIFY(data);
+        CORRADE_COMPARE(std::string(data, data.size()),
+            std::string("\xCA\xFE\xBA\xBE\x0D\x0A\x00\xDE\xAD\xBE\xEF", 11));
+    }
+
+    /* Nonexistent file */
+    CORRADE_VERIFY(!Directory::mapRead("nonexistent"));
+
+    /* Directories can't be mapped */
+    CORRADE_VERIFY(!Directory::mapRead(Directory::join(DIRECTORY_TEST_DIR, "dir")));
+    #else
+    CORRADE_SKIP("Not implemented on this platform.");
+    #endif
+}
+
+void DirectoryTest::mapReadEmpty() {
+    #if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_NACL)
+    const std::string empty = Directory::join(DIRECTORY_TEST_DIR, "dir/dummy");
+    CORRADE_VERIFY(Directory::fileExists(empty));
+    CORRADE_VERIFY(!Directory::mapRead(empty));
+    #else
+    CORRADE_SKIP("Not implemented on this platform.");
+    #endif
+}
+
+void DirectoryTest::mapReadHint() {
+    #if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_NACL)
+    for(Directory::MapHint hint: {Directory::MapHint::Sequential,
+                                  Directory::MapHint::Random,
+                                  Directory::MapHint::WillNeed}) {
+        const auto data = Directory::mapRead(Directory::join(DIRECTORY_TEST_DIR, "file"), hint);
+        CORRADE_COMPARE(data.size(), 11);
+        CORRADE_COMPARE(data[10], '\xEF');
+    }
+    #else
+    CORRADE_SKIP("Not implemented on this platform.");
+    #endif
+}
+
+void DirectoryTest::map() {
+    #if defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_NACL)
+    const std::string file = Directory::join(DIRECTORY_WRITE_TEST_DIR, "mapped");
+    if(Directory::fileExists(file))
+        CORRADE_VERIFY(Directory::rm(file));
+
+    {
+        constexpr unsigned char data[] = {0xCA, 0xFE, 0xBA, 0xBE, 0x0D, 0x0A, 0x00, 0xDE, 0xAD, 0xBE, 0xEF};
+        Containers::Array<char, Directory::MapDeleter> mapped = Directory::map(file, sizeof(data));
+        CORRADE_VERIFY(mapped);
+        CORRADE_COMPARE(mapped.size(), sizeof(data));
+        std::copy(data, data + sizeof(data), mapped.begin());
+    }
+
+    /* The data are written back after unmapping */
+    CORRADE_COMPARE_AS(file, Directory::join(DIRECTORY_TEST_DIR, "file"),
+        TestSuite::Compare::File);
+
+    /* Zero size can't be mapped, existing file is left untouched */
+    CORRADE_VERIFY(!Directory::map(file, 0));
+    CORRADE_COMPARE_AS(file, Directory::join(DIRECTORY_TEST_DIR, "file"),
+        TestSuite::Compare::File);
+
+    /* Empty mapped array */
+    const Containers::Array<char, Directory::MapDeleter> empty;
+    CORRADE_VERIFY(!empty);
+    #else
+    CORRADE_SKIP("Not implemented on this platform.");
+    #endif
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Corrade::Utility::Test::DirectoryTest)
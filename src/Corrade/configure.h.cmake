@@ -28,6 +28,7 @@
 #cmakedefine CORRADE_MSVC2015_COMPATIBILITY
 
 #cmakedefine CORRADE_BUILD_DEPRECATED
+#cmakedefine CORRADE_BUILD_INTERCONNECT_PROFILING
 #cmakedefine CORRADE_BUILD_STATIC
 
 #cmakedefine CORRADE_TARGET_APPLE